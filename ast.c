@@ -1,190 +1,114 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include "ast.h"
+#include "vectorize.h"
+#include "parallel.h"
+#include "passes.h"
+#include "output.h"
 
-// --- Function Table ---
-#define MAX_FUNCS 100
-typedef struct {
-    char *name;
-    ASTNode *def;
-} FuncEntry;
-
-FuncEntry func_table[MAX_FUNCS];
-int func_count = 0;
-
-void register_func(ASTNode *node) {
-    if (node->type == NODE_FUNCDEF) {
-        func_table[func_count].name = strdup(node->data.funcdef.name);
-        func_table[func_count].def = node;
-        func_count++;
-    }
-}
-
-ASTNode *find_func(const char *name) {
-    for (int i = 0; i < func_count; i++) {
-        if (strcmp(func_table[i].name, name) == 0)
-            return func_table[i].def;
-    }
-    return NULL;
-}
-
-// --- Symbol Table ---
-typedef struct {
-    char *name;
-    int value;
-    int is_global;
-} VarEntry;
-
-VarEntry symbol_table[100];
-int symbol_count = 0;
-
-void push_var(const char *name, int value, int is_global) {
-    symbol_table[symbol_count].name = strdup(name);
-    symbol_table[symbol_count].value = value;
-    symbol_table[symbol_count].is_global = is_global;
-    symbol_count++;
-}
-
-void pop_vars(int n) {
-    for (int i = 0; i < n; i++) {
-        free(symbol_table[symbol_count - 1].name);
-        symbol_count--;
-    }
-}
-
-int get_var(const char *name) {
-    for (int i = symbol_count - 1; i >= 0; i--) {
-        if (strcmp(symbol_table[i].name, name) == 0)
-            return symbol_table[i].value;
-    }
-    printf("Undefined variable: %s\n", name);
-    exit(1);
-}
+extern int yylineno;
 
-static int in_function = 0;
-
-void set_var(const char *name, int value) {
-    for (int i = symbol_count - 1; i >= 0; i--) {
-        if (strcmp(symbol_table[i].name, name) == 0) {
-            symbol_table[i].value = value;
-            return;
-        }
-    }
-    push_var(name, value, in_function == 0 ? 1 : 0);
-}
-
-void print_symbol_table(void) {
-    printf("\n--- Symbol Table ---\n");
-    for (int i = 0; i < symbol_count; i++) {
-        int is_latest = 1;
-        for (int j = i + 1; j < symbol_count; j++) {
-            if (strcmp(symbol_table[i].name, symbol_table[j].name) == 0) {
-                is_latest = 0;
-                break;
-            }
-        }
-        if (is_latest && symbol_table[i].is_global) {
-            printf("%s = %d\n", symbol_table[i].name, symbol_table[i].value);
-        }
-    }
+// --- AST Node Constructors ---
+static ASTNode *alloc_node(NodeType type) {
+    ASTNode *node = malloc(sizeof(ASTNode));
+    node->type = type;
+    node->line = yylineno;
+    return node;
 }
 
-// --- AST Node Constructors ---
 ASTNode *new_num(int val) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_NUM;
+    ASTNode *node = alloc_node(NODE_NUM);
     node->data.num_val = val;
     return node;
 }
 
 ASTNode *new_id(char *name) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_ID;
+    ASTNode *node = alloc_node(NODE_ID);
     node->data.id_name = strdup(name);
     return node;
 }
 
 ASTNode *new_binop(const char *op, ASTNode *left, ASTNode *right) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_BINOP;
+    ASTNode *node = alloc_node(NODE_BINOP);
     strncpy(node->data.binop.op, op, sizeof(node->data.binop.op) - 1);
     node->data.binop.op[sizeof(node->data.binop.op) - 1] = '\0';
     node->data.binop.left = left;
     node->data.binop.right = right;
+    if (left) node->line = left->line;
     return node;
 }
 
 ASTNode *new_assign(char *id, ASTNode *expr) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_ASSIGN;
+    ASTNode *node = alloc_node(NODE_ASSIGN);
     node->data.assign.id = strdup(id);
     node->data.assign.expr = expr;
     return node;
 }
 
 ASTNode *new_return(ASTNode *expr) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_RETURN;
+    ASTNode *node = alloc_node(NODE_RETURN);
     node->data.ret.expr = expr;
     return node;
 }
 
 ASTNode *new_if(ASTNode *cond, ASTNode *thenb, ASTNode *elseb) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_IF;
+    ASTNode *node = alloc_node(NODE_IF);
     node->data.if_stmt.cond = cond;
     node->data.if_stmt.then_branch = thenb;
     node->data.if_stmt.else_branch = elseb;
+    if (cond) node->line = cond->line;
     return node;
 }
 
 ASTNode *new_while(ASTNode *cond, ASTNode *body) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_WHILE;
+    ASTNode *node = alloc_node(NODE_WHILE);
     node->data.while_stmt.cond = cond;
     node->data.while_stmt.body = body;
+    if (cond) node->line = cond->line;
     return node;
 }
 
 ASTNode *new_for(ASTNode *init, ASTNode *cond, ASTNode *inc, ASTNode *body) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_FOR;
+    ASTNode *node = alloc_node(NODE_FOR);
     node->data.for_stmt.init = init;
     node->data.for_stmt.cond = cond;
     node->data.for_stmt.inc = inc;
     node->data.for_stmt.body = body;
+    node->data.for_stmt.vec = NULL;
+    node->data.for_stmt.par = NULL;
+    if (init) node->line = init->line;
+    else if (cond) node->line = cond->line;
     return node;
 }
 
 ASTNode *new_block(ASTNode **stmts, int count) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_BLOCK;
+    ASTNode *node = alloc_node(NODE_BLOCK);
     node->data.block.statements = stmts;
     node->data.block.count = count;
     return node;
 }
 
 ASTNode *new_print(char *id) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_PRINT;
+    ASTNode *node = alloc_node(NODE_PRINT);
     node->data.print_stmt.id = strdup(id);
     return node;
 }
 
 ASTNode *new_funcdef(char *name, char **params, int param_count, ASTNode *body) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_FUNCDEF;
+    ASTNode *node = alloc_node(NODE_FUNCDEF);
     node->data.funcdef.name = strdup(name);
     node->data.funcdef.params = params;
     node->data.funcdef.param_count = param_count;
     node->data.funcdef.body = body;
+    node->data.funcdef.compiled = 0;
+    node->data.funcdef.plan = NULL;
     return node;
 }
 
 ASTNode *new_funccall(char *name, ASTNode **args, int arg_count) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_FUNCCALL;
+    ASTNode *node = alloc_node(NODE_FUNCCALL);
     node->data.funccall.name = strdup(name);
     node->data.funccall.args = args;
     node->data.funccall.arg_count = arg_count;
@@ -192,591 +116,784 @@ ASTNode *new_funccall(char *name, ASTNode **args, int arg_count) {
 }
 
 ASTNode *new_break(void) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = NODE_BREAK;
+    ASTNode *node = alloc_node(NODE_BREAK);
     return node;
 }
 
-// --- Print AST as vertical tree ---
-void print_ast_tree_vertical(ASTNode *node, int depth, int is_last, int *draw_vertical) {
-    if (!node) return;
-    for (int i = 0; i < depth; i++) {
-        if (i == depth - 1) {
-            printf("%s", is_last ? "└── " : "├── ");
-        } else {
-            printf("%s", draw_vertical[i] ? "│   " : "    ");
-        }
-    }
-    switch (node->type) {
-        case NODE_NUM:
-            printf("%d\n", node->data.num_val);
-            break;
-        case NODE_ID:
-            printf("%s\n", node->data.id_name);
-            break;
-        case NODE_BINOP: {
-            printf("%s\n", node->data.binop.op);
-            int child_draw[64];
-            memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-            child_draw[depth] = 1;
-            print_ast_tree_vertical(node->data.binop.left, depth + 1, 0, child_draw);
-            child_draw[depth] = 0;
-            print_ast_tree_vertical(node->data.binop.right, depth + 1, 1, child_draw);
-            break;
-        }
-        case NODE_ASSIGN: {
-            printf("=\n");
-            int child_draw[64];
-            memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-            child_draw[depth] = 1;
-            print_ast_tree_vertical(new_id(node->data.assign.id), depth + 1, 0, child_draw);
-            child_draw[depth] = 0;
-            print_ast_tree_vertical(node->data.assign.expr, depth + 1, 1, child_draw);
-            break;
-        }
-        case NODE_RETURN:
-            printf("return\n");
-            print_ast_tree_vertical(node->data.ret.expr, depth + 1, 1, draw_vertical);
-            break;
-        case NODE_IF: {
-            printf("if\n");
-            int child_draw[64];
-            memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-            child_draw[depth] = 1;
-            print_ast_tree_vertical(node->data.if_stmt.cond, depth + 1, 0, child_draw);
-            child_draw[depth] = node->data.if_stmt.else_branch ? 1 : 0;
-            print_ast_tree_vertical(node->data.if_stmt.then_branch, depth + 1, node->data.if_stmt.else_branch ? 0 : 1, child_draw);
-            if (node->data.if_stmt.else_branch) {
-                child_draw[depth] = 0;
-                print_ast_tree_vertical(node->data.if_stmt.else_branch, depth + 1, 1, child_draw);
-            }
-            break;
-        }
-        case NODE_WHILE: {
-            printf("while\n");
-            int child_draw[64];
-            memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-            child_draw[depth] = 1;
-            print_ast_tree_vertical(node->data.while_stmt.cond, depth + 1, 0, child_draw);
-            child_draw[depth] = 0;
-            print_ast_tree_vertical(node->data.while_stmt.body, depth + 1, 1, child_draw);
-            break;
-        }
-        case NODE_FOR: {
-            printf("for\n");
-            int child_draw[64];
-            memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-            child_draw[depth] = 1;
-            print_ast_tree_vertical(node->data.for_stmt.init, depth + 1, 0, child_draw);
-            print_ast_tree_vertical(node->data.for_stmt.cond, depth + 1, 0, child_draw);
-            print_ast_tree_vertical(node->data.for_stmt.inc, depth + 1, 0, child_draw);
-            child_draw[depth] = 0;
-            print_ast_tree_vertical(node->data.for_stmt.body, depth + 1, 1, child_draw);
-            break;
-        }
-        case NODE_BLOCK: {
-            printf("block\n");
-            int n = node->data.block.count;
-            for (int i = 0; i < n; i++) {
-                int child_draw[64];
-                memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-                child_draw[depth] = (i != n - 1);
-                print_ast_tree_vertical(node->data.block.statements[i], depth + 1, i == n - 1, child_draw);
-            }
-            break;
-        }
-        case NODE_PRINT:
-            printf("print\n");
-            print_ast_tree_vertical(new_id(node->data.print_stmt.id), depth + 1, 1, draw_vertical);
-            break;
-        case NODE_FUNCDEF:
-            printf("func %s\n", node->data.funcdef.name);
-            break;
-        case NODE_FUNCCALL: {
-            printf("call %s\n", node->data.funccall.name);
-            int n = node->data.funccall.arg_count;
-            for (int i = 0; i < n; i++) {
-                int child_draw[64];
-                memcpy(child_draw, draw_vertical, sizeof(int) * depth);
-                child_draw[depth] = (i != n - 1);
-                print_ast_tree_vertical(node->data.funccall.args[i], depth + 1, i == n - 1, child_draw);
-            }
-            break;
-        }
-        case NODE_BREAK:
-            printf("break\n");
-            break;
+ASTNode *new_array_decl(char *name, ASTNode *size) {
+    ASTNode *node = alloc_node(NODE_ARRAY_DECL);
+    node->data.array_decl.name = strdup(name);
+    node->data.array_decl.size = size;
+    return node;
+}
+
+ASTNode *new_index(char *name, ASTNode *index) {
+    ASTNode *node = alloc_node(NODE_INDEX);
+    node->data.index.name = strdup(name);
+    node->data.index.index = index;
+    return node;
+}
+
+ASTNode *new_index_assign(char *name, ASTNode *index, ASTNode *expr) {
+    ASTNode *node = alloc_node(NODE_INDEX_ASSIGN);
+    node->data.index_assign.name = strdup(name);
+    node->data.index_assign.index = index;
+    node->data.index_assign.expr = expr;
+    return node;
+}
+
+// --- Traversal ---
+// The walkers themselves are inline in ast.h; only the slow paths live here.
+void walk_done(WalkStack *s) {
+    if (s->items != s->local) free(s->items);
+}
+
+void walk_grow(WalkStack *s) {
+    s->cap *= 2;
+    if (s->items == s->local) {
+        s->items = malloc(sizeof(WalkItem) * s->cap);
+        memcpy(s->items, s->local, sizeof(s->local));
+    } else {
+        s->items = realloc(s->items, sizeof(WalkItem) * s->cap);
     }
 }
 
-void print_ast(ASTNode *node, int indent) {
-    int draw_vertical[64] = {0};
-    print_ast_tree_vertical(node, 0, 1, draw_vertical);
-}
-
-// --- Evaluation ---
-int eval_expr(ASTNode *node) {
-    switch (node->type) {
-        case NODE_NUM: return node->data.num_val;
-        case NODE_ID: return get_var(node->data.id_name);
-        case NODE_BINOP: {
-            int l = eval_expr(node->data.binop.left);
-            int r = eval_expr(node->data.binop.right);
-            if (strcmp(node->data.binop.op, "+") == 0) return l + r;
-            if (strcmp(node->data.binop.op, "-") == 0) return l - r;
-            if (strcmp(node->data.binop.op, "*") == 0) return l * r;
-            if (strcmp(node->data.binop.op, "/") == 0) return l / r;
-            if (strcmp(node->data.binop.op, "==") == 0) return l == r;
-            if (strcmp(node->data.binop.op, "!=") == 0) return l != r;
-            if (strcmp(node->data.binop.op, "<") == 0) return l < r;
-            if (strcmp(node->data.binop.op, "<=") == 0) return l <= r;
-            if (strcmp(node->data.binop.op, ">") == 0) return l > r;
-            if (strcmp(node->data.binop.op, ">=") == 0) return l >= r;
-        }
-        default: printf("Unsupported expr\n"); exit(1);
+// --- Print AST as vertical tree ---
+typedef struct {
+    ASTNode *node;
+    const char *label; // printed as a leaf instead, for names held inline
+    int depth;
+    int is_last;
+} PrintItem;
+
+typedef struct {
+    PrintItem *items;
+    int count;
+    int cap;
+} PrintStack;
+
+static void print_push(PrintStack *s, ASTNode *node, const char *label, int depth, int is_last) {
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 64;
+        s->items = realloc(s->items, sizeof(PrintItem) * s->cap);
     }
+    s->items[s->count++] = (PrintItem){ node, label, depth, is_last };
 }
 
-// --- Interpretation ---
-static int break_encountered = 0;
+static void out_line(OutStream *out, const char *text, const char *name) {
+    stream_str(out, text);
+    if (name) stream_str(out, name);
+    stream_char(out, '\n');
+}
 
-void interpret(ASTNode *node) {
-    if (!node) return;
-    switch (node->type) {
-        case NODE_ASSIGN:
-            set_var(node->data.assign.id, eval_expr(node->data.assign.expr));
-            break;
-        case NODE_PRINT:
-            printf("%d\n", get_var(node->data.print_stmt.id));
-            break;
-        case NODE_BLOCK:
-            for (int i = 0; i < node->data.block.count; i++) {
-                interpret(node->data.block.statements[i]);
-                if (break_encountered) break;
-            }
-            break;
-        case NODE_WHILE:
-            while (eval_expr(node->data.while_stmt.cond)) {
-                break_encountered = 0;
-                interpret(node->data.while_stmt.body);
-                if (break_encountered) {
-                    break_encountered = 0;
-                    break;
-                }
-            }
-            break;
-        case NODE_FOR:
-            interpret(node->data.for_stmt.init);
-            while (eval_expr(node->data.for_stmt.cond)) {
-                break_encountered = 0;
-                interpret(node->data.for_stmt.body);
-                if (break_encountered) {
-                    break_encountered = 0;
-                    break;
-                }
-                interpret(node->data.for_stmt.inc);
-            }
-            break;
-        case NODE_IF:
-            if (eval_expr(node->data.if_stmt.cond)) {
-                interpret(node->data.if_stmt.then_branch);
-            } else if (node->data.if_stmt.else_branch) {
-                interpret(node->data.if_stmt.else_branch);
+void print_ast(ASTNode *node, int indent) {
+    OutStream *out = &out_stdout;
+    PrintStack s = {0};
+    char *draw_vertical = NULL; // [i]: the ancestor at depth i + 1 has siblings below it
+    int draw_cap = 0;
+    print_push(&s, node, NULL, 0, 1);
+    while (s.count) {
+        PrintItem item = s.items[--s.count];
+        if (!item.node && !item.label) continue;
+        int depth = item.depth;
+        if (depth >= draw_cap) {
+            draw_cap = draw_cap ? draw_cap * 2 : 64;
+            while (draw_cap <= depth) draw_cap *= 2;
+            draw_vertical = realloc(draw_vertical, draw_cap);
+        }
+        if (depth > 0) draw_vertical[depth - 1] = !item.is_last;
+        for (int i = 0; i < depth; i++) {
+            if (i == depth - 1) {
+                stream_str(out, item.is_last ? "└── " : "├── ");
+            } else {
+                stream_str(out, draw_vertical[i] ? "│   " : "    ");
             }
-            break;
-        case NODE_FUNCDEF:
-            register_func(node);
-            break;
-        case NODE_FUNCCALL: {
-            ASTNode *func = find_func(node->data.funccall.name);
-            if (!func) {
-                printf("Undefined function: %s\n", node->data.funccall.name);
-                exit(1);
+        }
+        if (item.label) {
+            out_line(out, item.label, NULL);
+            continue;
+        }
+        // Children are pushed last to first
+        node = item.node;
+        depth++;
+        switch (node->type) {
+            case NODE_NUM:
+                stream_int(out, node->data.num_val);
+                stream_char(out, '\n');
+                break;
+            case NODE_ID:
+                out_line(out, node->data.id_name, NULL);
+                break;
+            case NODE_BINOP:
+                out_line(out, node->data.binop.op, NULL);
+                print_push(&s, node->data.binop.right, NULL, depth, 1);
+                print_push(&s, node->data.binop.left, NULL, depth, 0);
+                break;
+            case NODE_ASSIGN:
+                out_line(out, "=", NULL);
+                print_push(&s, node->data.assign.expr, NULL, depth, 1);
+                print_push(&s, NULL, node->data.assign.id, depth, 0);
+                break;
+            case NODE_RETURN:
+                out_line(out, "return", NULL);
+                print_push(&s, node->data.ret.expr, NULL, depth, 1);
+                break;
+            case NODE_IF: {
+                ASTNode *else_branch = node->data.if_stmt.else_branch;
+                out_line(out, "if", NULL);
+                print_push(&s, else_branch, NULL, depth, 1);
+                print_push(&s, node->data.if_stmt.then_branch, NULL, depth, else_branch ? 0 : 1);
+                print_push(&s, node->data.if_stmt.cond, NULL, depth, 0);
+                break;
             }
-            int arg_values[func->data.funcdef.param_count];
-            for (int i = 0; i < func->data.funcdef.param_count; i++) {
-                arg_values[i] = eval_expr(node->data.funccall.args[i]);
+            case NODE_WHILE:
+                out_line(out, "while", NULL);
+                print_push(&s, node->data.while_stmt.body, NULL, depth, 1);
+                print_push(&s, node->data.while_stmt.cond, NULL, depth, 0);
+                break;
+            case NODE_FOR:
+                out_line(out, "for", NULL);
+                print_push(&s, node->data.for_stmt.body, NULL, depth, 1);
+                print_push(&s, node->data.for_stmt.inc, NULL, depth, 0);
+                print_push(&s, node->data.for_stmt.cond, NULL, depth, 0);
+                print_push(&s, node->data.for_stmt.init, NULL, depth, 0);
+                break;
+            case NODE_BLOCK: {
+                out_line(out, "block", NULL);
+                int n = node->data.block.count;
+                for (int i = n - 1; i >= 0; i--)
+                    print_push(&s, node->data.block.statements[i], NULL, depth, i == n - 1);
+                break;
             }
-            in_function++;
-            for (int i = 0; i < func->data.funcdef.param_count; i++) {
-                push_var(func->data.funcdef.params[i], arg_values[i], 0);
+            case NODE_PRINT:
+                out_line(out, "print", NULL);
+                print_push(&s, NULL, node->data.print_stmt.id, depth, 1);
+                break;
+            case NODE_FUNCDEF:
+                out_line(out, "func ", node->data.funcdef.name);
+                break;
+            case NODE_FUNCCALL: {
+                out_line(out, "call ", node->data.funccall.name);
+                int n = node->data.funccall.arg_count;
+                for (int i = n - 1; i >= 0; i--)
+                    print_push(&s, node->data.funccall.args[i], NULL, depth, i == n - 1);
+                break;
             }
-            interpret(func->data.funcdef.body);
-            pop_vars(func->data.funcdef.param_count);
-            in_function--;
-            break;
+            case NODE_BREAK:
+                out_line(out, "break", NULL);
+                break;
+            case NODE_ARRAY_DECL:
+                out_line(out, "array ", node->data.array_decl.name);
+                print_push(&s, node->data.array_decl.size, NULL, depth, 1);
+                break;
+            case NODE_INDEX:
+                out_line(out, "[]", NULL);
+                print_push(&s, node->data.index.index, NULL, depth, 1);
+                print_push(&s, NULL, node->data.index.name, depth, 0);
+                break;
+            case NODE_INDEX_ASSIGN:
+                out_line(out, "[]=", NULL);
+                print_push(&s, node->data.index_assign.expr, NULL, depth, 1);
+                print_push(&s, node->data.index_assign.index, NULL, depth, 0);
+                print_push(&s, NULL, node->data.index_assign.name, depth, 0);
+                break;
         }
-        case NODE_BREAK:
-            break_encountered = 1;
-            break;
-        default:
-            break;
     }
+    free(draw_vertical);
+    free(s.items);
+    stream_flush(out);
 }
 
 // --- AST Optimisation ---
-ASTNode* fold_constants(ASTNode *node) {
-    if (!node) return NULL;
-    switch (node->type) {
-        case NODE_BINOP: {
-            node->data.binop.left = fold_constants(node->data.binop.left);
-            node->data.binop.right = fold_constants(node->data.binop.right);
-            ASTNode *l = node->data.binop.left;
-            ASTNode *r = node->data.binop.right;
-            if (l && r && l->type == NODE_NUM && r->type == NODE_NUM) {
-                int result = 0;
-                if (strcmp(node->data.binop.op, "+") == 0) result = l->data.num_val + r->data.num_val;
-                else if (strcmp(node->data.binop.op, "-") == 0) result = l->data.num_val - r->data.num_val;
-                else if (strcmp(node->data.binop.op, "*") == 0) result = l->data.num_val * r->data.num_val;
-                else if (strcmp(node->data.binop.op, "/") == 0 && r->data.num_val != 0) result = l->data.num_val / r->data.num_val;
-                else return node;
-                free_ast(l);
-                free_ast(r);
-                ASTNode *num = new_num(result);
-                free(node);
-                return num;
-            }
-            return node;
+static ASTNode *fold_binop(ASTNode *node) {
+    ASTNode *l = node->data.binop.left;
+    ASTNode *r = node->data.binop.right;
+    if (!l || !r || l->type != NODE_NUM || r->type != NODE_NUM) return node;
+    int result = 0;
+    if (strcmp(node->data.binop.op, "+") == 0) result = l->data.num_val + r->data.num_val;
+    else if (strcmp(node->data.binop.op, "-") == 0) result = l->data.num_val - r->data.num_val;
+    else if (strcmp(node->data.binop.op, "*") == 0) result = l->data.num_val * r->data.num_val;
+    else if (strcmp(node->data.binop.op, "/") == 0 && r->data.num_val != 0
+             && !(l->data.num_val == INT_MIN && r->data.num_val == -1)) result = l->data.num_val / r->data.num_val;
+    else return node;
+    free(l); // plain numbers own nothing else
+    free(r);
+    ASTNode *num = new_num(result);
+    num->line = node->line;
+    free(node);
+    return num;
+}
+
+// Operators are folded on the way back up, once both operands are done.
+ASTNode* fold_constants(ASTNode *node, PassStats *stats) {
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        WalkItem item = s.items[--s.count];
+        if (item.state) {
+            *item.slot = fold_binop(item.node);
+            if (*item.slot != item.node) stats->removed += 2;
+            continue;
         }
-        case NODE_ASSIGN:
-            node->data.assign.expr = fold_constants(node->data.assign.expr);
-            return node;
-        case NODE_RETURN:
-            node->data.ret.expr = fold_constants(node->data.ret.expr);
-            return node;
-        case NODE_IF:
-            node->data.if_stmt.cond = fold_constants(node->data.if_stmt.cond);
-            node->data.if_stmt.then_branch = fold_constants(node->data.if_stmt.then_branch);
-            if (node->data.if_stmt.else_branch)
-                node->data.if_stmt.else_branch = fold_constants(node->data.if_stmt.else_branch);
-            return node;
-        case NODE_WHILE:
-            node->data.while_stmt.cond = fold_constants(node->data.while_stmt.cond);
-            node->data.while_stmt.body = fold_constants(node->data.while_stmt.body);
-            return node;
-        case NODE_FOR:
-            node->data.for_stmt.init = fold_constants(node->data.for_stmt.init);
-            node->data.for_stmt.cond = fold_constants(node->data.for_stmt.cond);
-            node->data.for_stmt.inc = fold_constants(node->data.for_stmt.inc);
-            node->data.for_stmt.body = fold_constants(node->data.for_stmt.body);
-            return node;
-        case NODE_BLOCK:
-            for (int i = 0; i < node->data.block.count; i++)
-                node->data.block.statements[i] = fold_constants(node->data.block.statements[i]);
-            return node;
-        case NODE_FUNCDEF:
-            node->data.funcdef.body = fold_constants(node->data.funcdef.body);
-            return node;
-        case NODE_FUNCCALL: {
-            for (int i = 0; i < node->data.funccall.arg_count; i++)
-                node->data.funccall.args[i] = fold_constants(node->data.funccall.args[i]);
-            return node;
+        ASTNode *n = item.node;
+        stats->visited++;
+        if (n->type == NODE_BINOP) {
+            NodeType l = n->data.binop.left->type, r = n->data.binop.right->type;
+            if ((l == NODE_NUM || l == NODE_ID) && (r == NODE_NUM || r == NODE_ID)) {
+                *item.slot = fold_binop(n); // nothing below to fold first
+                stats->visited += 2;
+                if (*item.slot != n) stats->removed += 2;
+                continue;
+            }
+            walk_push(&s, item.slot, 1);
         }
-        default:
-            return node;
+        if (n->type != NODE_FUNCDEF) // bodies are folded by compile_function()
+            walk_children(&s, n);
     }
+    walk_done(&s);
+    return node;
 }
 
-#include <stdbool.h>
-#include <stdint.h>
+static long free_tree(ASTNode *node);
 
-#define MAX_VARS 256
-static char *used_vars[MAX_VARS];
-static int used_var_count = 0;
+// --- Used-variable sets ---
+// Names read anywhere in the live program, including function bodies that
+// have not been compiled yet; their DCE runs against the same set later.
+struct UsedVars {
+    char **slots; // open addressing; names are copied, since DCE frees nodes
+    int cap;
+    int count;
+};
 
-static void mark_var_used(const char *name) {
-    for (int i = 0; i < used_var_count; i++)
-        if (strcmp(used_vars[i], name) == 0) return;
-    if (used_var_count < MAX_VARS)
-        used_vars[used_var_count++] = (char*)name;
+static unsigned hash_name(const char *name) {
+    unsigned h = 2166136261u;
+    for (; *name; name++) h = (h ^ (unsigned char)*name) * 16777619u;
+    return h;
 }
 
-static void collect_used_vars(ASTNode *node) {
-    if (!node) return;
-    switch (node->type) {
-        case NODE_ID:
-            mark_var_used(node->data.id_name);
-            break;
-        case NODE_BINOP:
-            collect_used_vars(node->data.binop.left);
-            collect_used_vars(node->data.binop.right);
-            break;
-        case NODE_ASSIGN:
-            collect_used_vars(node->data.assign.expr);
-            break;
-        case NODE_RETURN:
-            collect_used_vars(node->data.ret.expr);
-            break;
-        case NODE_IF:
-            collect_used_vars(node->data.if_stmt.cond);
-            collect_used_vars(node->data.if_stmt.then_branch);
-            if (node->data.if_stmt.else_branch)
-                collect_used_vars(node->data.if_stmt.else_branch);
-            break;
-        case NODE_WHILE:
-            collect_used_vars(node->data.while_stmt.cond);
-            collect_used_vars(node->data.while_stmt.body);
-            break;
-        case NODE_FOR:
-            collect_used_vars(node->data.for_stmt.init);
-            collect_used_vars(node->data.for_stmt.cond);
-            collect_used_vars(node->data.for_stmt.inc);
-            collect_used_vars(node->data.for_stmt.body);
-            break;
-        case NODE_BLOCK:
-            for (int i = 0; i < node->data.block.count; i++)
-                collect_used_vars(node->data.block.statements[i]);
-            break;
-        case NODE_PRINT:
-            mark_var_used(node->data.print_stmt.id);
-            break;
-        case NODE_FUNCCALL:
-            for (int i = 0; i < node->data.funccall.arg_count; i++)
-                collect_used_vars(node->data.funccall.args[i]);
-            break;
-        case NODE_FUNCDEF:
-            collect_used_vars(node->data.funcdef.body);
-            break;
-        default:
-            break;
-    }
+static int used_slot(const UsedVars *set, const char *name) {
+    int i = hash_name(name) & (set->cap - 1);
+    while (set->slots[i] && strcmp(set->slots[i], name) != 0)
+        i = (i + 1) & (set->cap - 1);
+    return i;
 }
 
-static bool is_var_used(const char *name) {
-    for (int i = 0; i < used_var_count; i++)
-        if (strcmp(used_vars[i], name) == 0) return true;
-    return false;
-}
-
-ASTNode* eliminate_dead_assignments(ASTNode *node) {
-    if (!node) return NULL;
-    switch (node->type) {
-        case NODE_BLOCK: {
-            int n = node->data.block.count;
-            ASTNode **stmts = node->data.block.statements;
-            int new_count = 0;
-            for (int i = 0; i < n; i++) {
-                stmts[i] = eliminate_dead_assignments(stmts[i]);
-                if (stmts[i] && stmts[i]->type == NODE_ASSIGN) {
-                    if (!is_var_used(stmts[i]->data.assign.id)) {
-                        free_ast(stmts[i]);
-                        stmts[i] = NULL;
+static void mark_var_used(UsedVars *set, const char *name) {
+    if ((set->count + 1) * 2 > set->cap) {
+        UsedVars old = *set;
+        set->cap = old.cap ? old.cap * 2 : 64;
+        set->slots = calloc(set->cap, sizeof(char *));
+        for (int i = 0; i < old.cap; i++)
+            if (old.slots[i]) set->slots[used_slot(set, old.slots[i])] = old.slots[i];
+        free(old.slots);
+    }
+    int i = used_slot(set, name);
+    if (set->slots[i]) return;
+    set->slots[i] = strdup(name);
+    set->count++;
+}
+
+static int is_var_used(const UsedVars *set, const char *name) {
+    return set->cap && set->slots[used_slot(set, name)] != NULL;
+}
+
+void used_free(UsedVars *set) {
+    if (!set) return;
+    for (int i = 0; i < set->cap; i++)
+        free(set->slots[i]);
+    free(set->slots);
+    free(set);
+}
+
+// With keep_assigned, every assignment target is used too. Function bodies
+// can assign globals, so they are not told apart from top-level code.
+UsedVars *collect_used_vars(ASTNode *node, int keep_assigned, PassStats *stats) {
+    UsedVars *used = calloc(1, sizeof(UsedVars));
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        ASTNode *n = s.items[--s.count].node;
+        stats->visited++;
+        switch (n->type) {
+            case NODE_ID:
+                mark_var_used(used, n->data.id_name);
+                break;
+            case NODE_PRINT:
+                mark_var_used(used, n->data.print_stmt.id);
+                break;
+            case NODE_INDEX:
+                mark_var_used(used, n->data.index.name);
+                break;
+            case NODE_ASSIGN:
+                if (keep_assigned) mark_var_used(used, n->data.assign.id);
+                break;
+            case NODE_FUNCDEF:
+                walk_push(&s, &n->data.funcdef.body, 0);
+                break;
+            default:
+                break;
+        }
+        walk_children(&s, n);
+    }
+    walk_done(&s);
+    return used;
+}
+
+// Assignments to variables nothing reads are dropped from every block,
+// outside function bodies (see compile_function()).
+ASTNode* eliminate_dead_assignments(UsedVars *used, ASTNode *node, PassStats *stats) {
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        ASTNode *n = s.items[--s.count].node;
+        stats->visited++;
+        switch (n->type) {
+            case NODE_BLOCK: {
+                ASTNode **stmts = n->data.block.statements;
+                int new_count = 0;
+                stats->visited += n->data.block.count;
+                for (int i = 0; i < n->data.block.count; i++) {
+                    if (stmts[i]->type == NODE_ASSIGN && !is_var_used(used, stmts[i]->data.assign.id)) {
+                        stats->removed += free_tree(stmts[i]);
                         continue;
                     }
+                    stmts[new_count++] = stmts[i];
+                }
+                n->data.block.count = new_count;
+                for (int i = new_count - 1; i >= 0; i--) {
+                    NodeType t = stmts[i]->type;
+                    if (t == NODE_BLOCK || t == NODE_IF || t == NODE_WHILE || t == NODE_FOR)
+                        walk_push(&s, &stmts[i], 0);
                 }
-                if (stmts[i]) stmts[new_count++] = stmts[i];
+                break;
             }
-            node->data.block.count = new_count;
-            return node;
+            case NODE_IF:
+                walk_push(&s, &n->data.if_stmt.else_branch, 0);
+                walk_push(&s, &n->data.if_stmt.then_branch, 0);
+                break;
+            case NODE_WHILE:
+                walk_push(&s, &n->data.while_stmt.body, 0);
+                break;
+            case NODE_FOR:
+                walk_push(&s, &n->data.for_stmt.body, 0);
+                break;
+            default:
+                break;
         }
-        case NODE_ASSIGN:
-            node->data.assign.expr = eliminate_dead_assignments(node->data.assign.expr);
-            return node;
-        case NODE_BINOP:
-            node->data.binop.left = eliminate_dead_assignments(node->data.binop.left);
-            node->data.binop.right = eliminate_dead_assignments(node->data.binop.right);
-            return node;
-        case NODE_IF:
-            node->data.if_stmt.cond = eliminate_dead_assignments(node->data.if_stmt.cond);
-            node->data.if_stmt.then_branch = eliminate_dead_assignments(node->data.if_stmt.then_branch);
-            if (node->data.if_stmt.else_branch)
-                node->data.if_stmt.else_branch = eliminate_dead_assignments(node->data.if_stmt.else_branch);
-            return node;
-        case NODE_WHILE:
-            node->data.while_stmt.cond = eliminate_dead_assignments(node->data.while_stmt.cond);
-            node->data.while_stmt.body = eliminate_dead_assignments(node->data.while_stmt.body);
-            return node;
-        case NODE_FOR:
-            node->data.for_stmt.init = eliminate_dead_assignments(node->data.for_stmt.init);
-            node->data.for_stmt.cond = eliminate_dead_assignments(node->data.for_stmt.cond);
-            node->data.for_stmt.inc = eliminate_dead_assignments(node->data.for_stmt.inc);
-            node->data.for_stmt.body = eliminate_dead_assignments(node->data.for_stmt.body);
-            return node;
-        case NODE_FUNCDEF:
-            node->data.funcdef.body = eliminate_dead_assignments(node->data.funcdef.body);
-            return node;
-        default:
-            return node;
     }
+    walk_done(&s);
+    return node;
 }
 
-void optimise_ast(ASTNode *root) {
-    fold_constants(root);
-    used_var_count = 0;
-    collect_used_vars(root);
-    eliminate_dead_assignments(root);
+// --- Dead function elimination ---
+// Calls are resolved by name at run time, so a definition is live when its
+// name is called from top-level code or from the body of a live function.
+typedef struct {
+    const char **names;
+    int count;
+    int cap;
+} NameList;
+
+static void collect_calls(ASTNode *node, NameList *calls, PassStats *stats) {
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        ASTNode *n = s.items[--s.count].node;
+        stats->visited++;
+        if (n->type == NODE_FUNCDEF) continue;
+        if (n->type == NODE_FUNCCALL) {
+            if (calls->count == calls->cap) {
+                calls->cap = calls->cap ? calls->cap * 2 : 64;
+                calls->names = realloc(calls->names, sizeof(char *) * calls->cap);
+            }
+            calls->names[calls->count++] = n->data.funccall.name;
+        }
+        walk_children(&s, n);
+    }
+    walk_done(&s);
+}
+
+static ASTNode **sort_stmts; // qsort has no context argument
+
+static int cmp_def_name(const void *a, const void *b) {
+    return strcmp(sort_stmts[*(const int *)a]->data.funcdef.name, sort_stmts[*(const int *)b]->data.funcdef.name);
+}
+
+void eliminate_dead_functions(ASTNode *root, PassStats *stats) {
+    if (!root || root->type != NODE_BLOCK) return;
+    ASTNode **stmts = root->data.block.statements;
+    int n = root->data.block.count;
+    int *defs = malloc(sizeof(int) * (n + 1)); // statement indices, sorted by name
+    int def_count = 0;
+    NameList calls = {0};
+    for (int i = 0; i < n; i++)
+        if (stmts[i]->type == NODE_FUNCDEF) defs[def_count++] = i;
+    collect_calls(root, &calls, stats); // top-level code only
+    sort_stmts = stmts;
+    qsort(defs, def_count, sizeof(int), cmp_def_name);
+
+    // The call list doubles as the work list: live bodies append to it
+    char *live = calloc(def_count + 1, 1);
+    for (int next = 0; next < calls.count; next++) {
+        const char *name = calls.names[next];
+        int lo = 0, hi = def_count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (strcmp(stmts[defs[mid]]->data.funcdef.name, name) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        for (int d = lo; d < def_count && strcmp(stmts[defs[d]]->data.funcdef.name, name) == 0; d++) {
+            if (live[d]) continue;
+            live[d] = 1;
+            collect_calls(stmts[defs[d]]->data.funcdef.body, &calls, stats);
+        }
+    }
+
+    for (int d = 0; d < def_count; d++) {
+        if (live[d]) continue;
+        stats->removed += free_tree(stmts[defs[d]]);
+        stmts[defs[d]] = NULL;
+    }
+    int kept = 0;
+    for (int i = 0; i < n; i++)
+        if (stmts[i]) stmts[kept++] = stmts[i];
+    root->data.block.count = kept;
+    free(live);
+    free(defs);
+    free(calls.names);
 }
 
 // --- Intermediate Code Generation ---
+// Lines go to out_stdout. Operands are never formatted into strings: a value
+// is either a variable, named by the tree, or a numbered temporary.
+typedef struct {
+    const char *name; // NULL for a temporary
+    int temp;         // -1 for no expression at all
+} Operand;
+
 int temp_counter = 0;
-char* new_temp() {
-    char *buf = malloc(16);
-    sprintf(buf, "t%d", temp_counter++);
-    return buf;
-}
-
-char* gen_expr_code(ASTNode *node) {
-    if (!node) return NULL;
-    char *res, *l, *r;
-    switch (node->type) {
-        case NODE_NUM: {
-            res = new_temp();
-            printf("%s = %d\n", res, node->data.num_val);
-            return res;
+static Operand new_temp(void) {
+    return (Operand){ NULL, temp_counter++ };
+}
+
+static void ir_operand(Operand op) {
+    if (op.name) {
+        stream_str(&out_stdout, op.name);
+    } else if (op.temp >= 0) {
+        stream_char(&out_stdout, 't');
+        stream_int(&out_stdout, op.temp);
+    } else {
+        stream_str(&out_stdout, "(null)"); // what printf made of it
+    }
+}
+
+static void ir_str(const char *text) {
+    stream_str(&out_stdout, text);
+}
+
+static void ir_label(const char *prefix, int label, const char *suffix) {
+    stream_str(&out_stdout, prefix);
+    stream_char(&out_stdout, 'L');
+    stream_int(&out_stdout, label);
+    stream_str(&out_stdout, suffix);
+}
+
+// Operands are generated first, left to right; their values wait on a stack.
+static Operand gen_expr_code(ASTNode *node) {
+    if (!node) return (Operand){ NULL, -1 };
+    WalkStack s;
+    walk_init(&s);
+    Operand local[32];
+    Operand *vals = local;
+    int count = 0, cap = 32;
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        WalkItem item = s.items[--s.count];
+        ASTNode *n = item.node;
+        Operand res = { NULL, -1 }, l, r;
+        if (item.state == 0 && (n->type == NODE_BINOP || n->type == NODE_INDEX)) {
+            walk_push(&s, item.slot, 1);
+            walk_children(&s, n);
+            continue;
         }
-        case NODE_ID: {
-            return strdup(node->data.id_name);
+        switch (n->type) {
+            case NODE_NUM:
+                res = new_temp();
+                ir_operand(res);
+                ir_str(" = ");
+                stream_int(&out_stdout, n->data.num_val);
+                ir_str("\n");
+                break;
+            case NODE_ID:
+                res.name = n->data.id_name;
+                break;
+            case NODE_BINOP:
+                r = vals[--count];
+                l = vals[--count];
+                res = new_temp();
+                ir_operand(res);
+                ir_str(" = ");
+                ir_operand(l);
+                ir_str(" ");
+                ir_str(n->data.binop.op);
+                ir_str(" ");
+                ir_operand(r);
+                ir_str("\n");
+                break;
+            case NODE_INDEX:
+                l = vals[--count];
+                res = new_temp();
+                ir_operand(res);
+                ir_str(" = ");
+                ir_str(n->data.index.name);
+                ir_str("[");
+                ir_operand(l);
+                ir_str("]\n");
+                break;
+            default:
+                break;
         }
-        case NODE_BINOP: {
-            l = gen_expr_code(node->data.binop.left);
-            r = gen_expr_code(node->data.binop.right);
-            res = new_temp();
-            printf("%s = %s %s %s\n", res, l, node->data.binop.op, r);
-            free(l); free(r);
-            return res;
+        if (count == cap) {
+            cap *= 2;
+            if (vals == local) {
+                vals = malloc(sizeof(Operand) * cap);
+                memcpy(vals, local, sizeof(local));
+            } else {
+                vals = realloc(vals, sizeof(Operand) * cap);
+            }
         }
-        default:
-            return NULL;
+        vals[count++] = res;
     }
+    walk_done(&s);
+    Operand res = vals[0];
+    if (vals != local) free(vals);
+    return res;
 }
 
-void generate_intermediate_code(ASTNode *node) {
+// Statements that wrap others come back off the stack (state 1, 2) to finish
+// once their nested statements have been generated.
+typedef struct {
+    ASTNode *node;
+    int state;
+    int start; // labels allocated on the way in
+    int end;
+} IRItem;
+
+typedef struct {
+    IRItem *items;
+    int count;
+    int cap;
+} IRStack;
+
+static void ir_push(IRStack *s, ASTNode *node, int state, int start, int end) {
     if (!node) return;
-    switch (node->type) {
-        case NODE_ASSIGN: {
-            char *rhs = gen_expr_code(node->data.assign.expr);
-            printf("%s = %s\n", node->data.assign.id, rhs);
-            free(rhs);
-            break;
-        }
-        case NODE_PRINT: {
-            printf("print %s\n", node->data.print_stmt.id);
-            break;
-        }
-        case NODE_BLOCK:
-            for (int i = 0; i < node->data.block.count; i++)
-                generate_intermediate_code(node->data.block.statements[i]);
-            break;
-        case NODE_WHILE: {
-            static int label_counter = 0;
-            int start = label_counter++;
-            int end = label_counter++;
-            printf("L%d:\n", start);
-            char *cond = gen_expr_code(node->data.while_stmt.cond);
-            printf("ifnot %s goto L%d\n", cond, end);
-            free(cond);
-            generate_intermediate_code(node->data.while_stmt.body);
-            printf("goto L%d\n", start);
-            printf("L%d:\n", end);
-            break;
-        }
-        case NODE_FOR: {
-            static int label_counter = 1000;
-            int start = label_counter++;
-            int end = label_counter++;
-            generate_intermediate_code(node->data.for_stmt.init);
-            printf("L%d:\n", start);
-            char *cond = gen_expr_code(node->data.for_stmt.cond);
-            printf("ifnot %s goto L%d\n", cond, end);
-            free(cond);
-            generate_intermediate_code(node->data.for_stmt.body);
-            generate_intermediate_code(node->data.for_stmt.inc);
-            printf("goto L%d\n", start);
-            printf("L%d:\n", end);
-            break;
-        }
-        case NODE_IF: {
-            static int label_counter = 2000;
-            int else_label = label_counter++;
-            int end_label = label_counter++;
-            char *cond = gen_expr_code(node->data.if_stmt.cond);
-            printf("ifnot %s goto L%d\n", cond, else_label);
-            free(cond);
-            generate_intermediate_code(node->data.if_stmt.then_branch);
-            printf("goto L%d\n", end_label);
-            printf("L%d:\n", else_label);
-            if (node->data.if_stmt.else_branch)
-                generate_intermediate_code(node->data.if_stmt.else_branch);
-            printf("L%d:\n", end_label);
-            break;
-        }
-        case NODE_FUNCDEF: {
-            printf("func %s:\n", node->data.funcdef.name);
-            generate_intermediate_code(node->data.funcdef.body);
-            printf("endfunc %s\n", node->data.funcdef.name);
-            break;
-        }
-        case NODE_FUNCCALL: {
-            printf("call %s\n", node->data.funccall.name);
-            for (int i = 0; i < node->data.funccall.arg_count; i++) {
-                char *arg = gen_expr_code(node->data.funccall.args[i]);
-                printf("arg %s\n", arg);
-                free(arg);
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 64;
+        s->items = realloc(s->items, sizeof(IRItem) * s->cap);
+    }
+    s->items[s->count++] = (IRItem){ node, state, start, end };
+}
+
+// "ifnot <cond> goto L<label>"
+static void ir_branch(ASTNode *cond, int label) {
+    Operand op = gen_expr_code(cond);
+    ir_str("ifnot ");
+    ir_operand(op);
+    ir_label(" goto ", label, "\n");
+}
+
+void generate_intermediate_code(ASTNode *root) {
+    static int while_labels = 0, for_labels = 1000, if_labels = 2000;
+    IRStack s = {0};
+    ir_push(&s, root, 0, 0, 0);
+    while (s.count) {
+        IRItem item = s.items[--s.count];
+        ASTNode *node = item.node;
+        switch (node->type) {
+            case NODE_ASSIGN: {
+                Operand rhs = gen_expr_code(node->data.assign.expr);
+                ir_str(node->data.assign.id);
+                ir_str(" = ");
+                ir_operand(rhs);
+                ir_str("\n");
+                break;
+            }
+            case NODE_PRINT: {
+                ir_str("print ");
+                ir_str(node->data.print_stmt.id);
+                ir_str("\n");
+                break;
+            }
+            case NODE_BLOCK:
+                for (int i = node->data.block.count - 1; i >= 0; i--)
+                    ir_push(&s, node->data.block.statements[i], 0, 0, 0);
+                break;
+            case NODE_WHILE: {
+                if (item.state == 1) {
+                    ir_label("goto ", item.start, "\n");
+                    ir_label("", item.end, ":\n");
+                    break;
+                }
+                int start = while_labels++;
+                int end = while_labels++;
+                ir_label("", start, ":\n");
+                ir_branch(node->data.while_stmt.cond, end);
+                ir_push(&s, node, 1, start, end);
+                ir_push(&s, node->data.while_stmt.body, 0, 0, 0);
+                break;
+            }
+            case NODE_FOR: {
+                if (item.state == 0) {
+                    ir_push(&s, node, 1, for_labels, for_labels + 1);
+                    for_labels += 2;
+                    ir_push(&s, node->data.for_stmt.init, 0, 0, 0);
+                } else if (item.state == 1) {
+                    ir_label("", item.start, ":\n");
+                    ir_branch(node->data.for_stmt.cond, item.end);
+                    ir_push(&s, node, 2, item.start, item.end);
+                    ir_push(&s, node->data.for_stmt.inc, 0, 0, 0);
+                    ir_push(&s, node->data.for_stmt.body, 0, 0, 0);
+                } else {
+                    ir_label("goto ", item.start, "\n");
+                    ir_label("", item.end, ":\n");
+                }
+                break;
+            }
+            case NODE_IF: {
+                if (item.state == 0) {
+                    int else_label = if_labels++;
+                    int end_label = if_labels++;
+                    ir_branch(node->data.if_stmt.cond, else_label);
+                    ir_push(&s, node, 1, else_label, end_label);
+                    ir_push(&s, node->data.if_stmt.then_branch, 0, 0, 0);
+                } else if (item.state == 1) {
+                    ir_label("goto ", item.end, "\n");
+                    ir_label("", item.start, ":\n");
+                    ir_push(&s, node, 2, item.start, item.end);
+                    ir_push(&s, node->data.if_stmt.else_branch, 0, 0, 0);
+                } else {
+                    ir_label("", item.end, ":\n");
+                }
+                break;
+            }
+            case NODE_FUNCDEF: {
+                if (item.state == 1) {
+                    ir_str("endfunc ");
+                    ir_str(node->data.funcdef.name);
+                    ir_str("\n");
+                    break;
+                }
+                compile_function(node);
+                ir_str("func ");
+                ir_str(node->data.funcdef.name);
+                ir_str(":\n");
+                ir_push(&s, node, 1, 0, 0);
+                ir_push(&s, node->data.funcdef.body, 0, 0, 0);
+                break;
+            }
+            case NODE_FUNCCALL: {
+                ir_str("call ");
+                ir_str(node->data.funccall.name);
+                ir_str("\n");
+                for (int i = 0; i < node->data.funccall.arg_count; i++) {
+                    Operand arg = gen_expr_code(node->data.funccall.args[i]);
+                    ir_str("arg ");
+                    ir_operand(arg);
+                    ir_str("\n");
+                }
+                ir_str("endcall\n");
+                break;
+            }
+            case NODE_ARRAY_DECL: {
+                Operand size = gen_expr_code(node->data.array_decl.size);
+                ir_str("array ");
+                ir_str(node->data.array_decl.name);
+                ir_str("[");
+                ir_operand(size);
+                ir_str("]\n");
+                break;
             }
-            printf("endcall\n");
-            break;
+            case NODE_INDEX_ASSIGN: {
+                Operand index = gen_expr_code(node->data.index_assign.index);
+                Operand rhs = gen_expr_code(node->data.index_assign.expr);
+                ir_str(node->data.index_assign.name);
+                ir_str("[");
+                ir_operand(index);
+                ir_str("] = ");
+                ir_operand(rhs);
+                ir_str("\n");
+                break;
+            }
+            default:
+                break;
         }
-        default:
-            break;
     }
+    free(s.items);
+    stream_flush(&out_stdout);
 }
 
 // --- Free AST ---
-void free_ast(ASTNode *node) {
-    if (!node) return;
-    switch (node->type) {
-        case NODE_ID: free(node->data.id_name); break;
-        case NODE_ASSIGN:
-            free(node->data.assign.id);
-            free_ast(node->data.assign.expr);
-            break;
-        case NODE_BINOP:
-            free_ast(node->data.binop.left);
-            free_ast(node->data.binop.right);
-            break;
-        case NODE_RETURN:
-            free_ast(node->data.ret.expr);
-            break;
-        case NODE_IF:
-            free_ast(node->data.if_stmt.cond);
-            free_ast(node->data.if_stmt.then_branch);
-            if (node->data.if_stmt.else_branch)
-                free_ast(node->data.if_stmt.else_branch);
-            break;
-        case NODE_WHILE:
-            free_ast(node->data.while_stmt.cond);
-            free_ast(node->data.while_stmt.body);
-            break;
-        case NODE_FOR:
-            free_ast(node->data.for_stmt.init);
-            free_ast(node->data.for_stmt.cond);
-            free_ast(node->data.for_stmt.inc);
-            free_ast(node->data.for_stmt.body);
-            break;
-        case NODE_BLOCK:
-            for (int i = 0; i < node->data.block.count; i++)
-                free_ast(node->data.block.statements[i]);
-            free(node->data.block.statements);
-            break;
-        case NODE_PRINT:
-            free(node->data.print_stmt.id);
-            break;
-        case NODE_NUM:
-            break;
-        case NODE_FUNCDEF:
-            free(node->data.funcdef.name);
-            for (int i = 0; i < node->data.funcdef.param_count; i++) {
-                free(node->data.funcdef.params[i]);
-            }
-            free(node->data.funcdef.params);
-            free_ast(node->data.funcdef.body);
-            break;
-        case NODE_FUNCCALL:
-            free(node->data.funccall.name);
-            free(node->data.funccall.args);
-            break;
-        case NODE_BREAK:
-            break;
+// Children are pushed before their parent's own storage goes. Returns the
+// number of nodes freed.
+static long free_tree(ASTNode *node) {
+    long freed = 0;
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        node = s.items[--s.count].node;
+        walk_children(&s, node);
+        switch (node->type) {
+            case NODE_ID: free(node->data.id_name); break;
+            case NODE_ASSIGN:
+                free(node->data.assign.id);
+                break;
+            case NODE_FOR:
+                vec_free(node->data.for_stmt.vec);
+                par_free(node->data.for_stmt.par);
+                break;
+            case NODE_BLOCK:
+                free(node->data.block.statements);
+                break;
+            case NODE_PRINT:
+                free(node->data.print_stmt.id);
+                break;
+            case NODE_FUNCDEF:
+                free(node->data.funcdef.name);
+                for (int i = 0; i < node->data.funcdef.param_count; i++) {
+                    free(node->data.funcdef.params[i]);
+                }
+                free(node->data.funcdef.params);
+                walk_push(&s, &node->data.funcdef.body, 0);
+                pass_plan_release(node->data.funcdef.plan);
+                break;
+            case NODE_FUNCCALL:
+                free(node->data.funccall.name);
+                free(node->data.funccall.args);
+                break;
+            case NODE_ARRAY_DECL:
+                free(node->data.array_decl.name);
+                break;
+            case NODE_INDEX:
+                free(node->data.index.name);
+                break;
+            case NODE_INDEX_ASSIGN:
+                free(node->data.index_assign.name);
+                break;
+            default:
+                break;
+        }
+        free(node);
+        freed++;
     }
-    free(node);
+    walk_done(&s);
+    return freed;
+}
+
+void free_ast(ASTNode *node) {
+    free_tree(node);
 }
@@ -14,13 +14,22 @@ typedef enum {
     NODE_PRINT,
     NODE_FUNCDEF,
     NODE_FUNCCALL,
-    NODE_BREAK
+    NODE_BREAK,
+    NODE_ARRAY_DECL,
+    NODE_INDEX,
+    NODE_INDEX_ASSIGN
 } NodeType;
 
 typedef struct ASTNode ASTNode;
+typedef struct VecLoop VecLoop;
+typedef struct ParLoop ParLoop;
+typedef struct UsedVars UsedVars;
+typedef struct PassStats PassStats;
+typedef struct PassPlan PassPlan;
 
 struct ASTNode {
     NodeType type;
+    int line; // source line the node was parsed on
     union {
         int num_val;
         char *id_name;
@@ -50,6 +59,8 @@ struct ASTNode {
             ASTNode *cond;
             ASTNode *inc;
             ASTNode *body;
+            VecLoop *vec; // set by vectorize_loops() for element-wise loops
+            ParLoop *par; // set by parallelize_loops() for reduction loops
         } for_stmt;
         struct {
             ASTNode **statements;
@@ -63,12 +74,27 @@ struct ASTNode {
             char **params;
             int param_count;
             ASTNode *body;
+            int compiled;   // body optimised; see compile_function()
+            PassPlan *plan; // passes still to run on the body, until compiled
         } funcdef;
         struct { // Function call
             char *name;
             ASTNode **args;
             int arg_count;
         } funccall;
+        struct { // array name[size];
+            char *name;
+            ASTNode *size;
+        } array_decl;
+        struct { // name[index]
+            char *name;
+            ASTNode *index;
+        } index;
+        struct { // name[index] = expr;
+            char *name;
+            ASTNode *index;
+            ASTNode *expr;
+        } index_assign;
     } data;
 };
 
@@ -85,12 +111,116 @@ ASTNode *new_if(ASTNode *cond, ASTNode *thenb, ASTNode *elseb);
 ASTNode *new_while(ASTNode *cond, ASTNode *body);
 ASTNode *new_for(ASTNode *init, ASTNode *cond, ASTNode *inc, ASTNode *body);
 ASTNode *new_break(void);
+ASTNode *new_array_decl(char *name, ASTNode *size);
+ASTNode *new_index(char *name, ASTNode *index);
+ASTNode *new_index_assign(char *name, ASTNode *index, ASTNode *expr);
 
 void print_ast(ASTNode *node, int indent);
 void interpret(ASTNode *node);
 void free_ast(ASTNode *node);
-void optimise_ast(ASTNode *root);
+void optimise_ast(ASTNode *root); // the default pipeline; see passes.h
 void generate_intermediate_code(ASTNode *root);
 void print_symbol_table(void);
+void reset_runtime(void);
+
+// --- Optimisation passes, driven by passes.c ---
+ASTNode *fold_constants(ASTNode *node, PassStats *stats);
+UsedVars *collect_used_vars(ASTNode *root, int keep_assigned, PassStats *stats);
+void used_free(UsedVars *set);
+ASTNode *eliminate_dead_assignments(UsedVars *used, ASTNode *node, PassStats *stats);
+void eliminate_dead_functions(ASTNode *root, PassStats *stats);
+
+// --- Traversal ---
+// Passes walk the tree with an explicit stack rather than recursing, so deeply
+// nested statements and long operator chains cannot overflow the C stack.
+typedef struct {
+    ASTNode *node;
+    ASTNode **slot; // where node hangs, for passes that replace it
+    long state;     // pass-specific; 0 on the way down
+} WalkItem;
+
+typedef struct {
+    WalkItem *items;
+    int count;
+    int cap;
+    WalkItem local[32]; // most walks never need the heap
+} WalkStack;
+
+void walk_grow(WalkStack *s);
+void walk_done(WalkStack *s);
+
+static inline void walk_init(WalkStack *s) {
+    s->items = s->local;
+    s->count = 0;
+    s->cap = sizeof(s->local) / sizeof(s->local[0]);
+}
+
+static inline void walk_push(WalkStack *s, ASTNode **slot, long state) {
+    if (!*slot) return;
+    if (s->count == s->cap) walk_grow(s);
+    WalkItem *item = &s->items[s->count++];
+    item->node = *slot;
+    item->slot = slot;
+    item->state = state;
+}
+
+// Push node's children so that they pop in source order. Function bodies are
+// left to the caller, since most passes skip them.
+static inline void walk_children(WalkStack *s, ASTNode *node) {
+    switch (node->type) {
+        case NODE_BINOP:
+            walk_push(s, &node->data.binop.right, 0);
+            walk_push(s, &node->data.binop.left, 0);
+            break;
+        case NODE_ASSIGN:
+            walk_push(s, &node->data.assign.expr, 0);
+            break;
+        case NODE_RETURN:
+            walk_push(s, &node->data.ret.expr, 0);
+            break;
+        case NODE_IF:
+            walk_push(s, &node->data.if_stmt.else_branch, 0);
+            walk_push(s, &node->data.if_stmt.then_branch, 0);
+            walk_push(s, &node->data.if_stmt.cond, 0);
+            break;
+        case NODE_WHILE:
+            walk_push(s, &node->data.while_stmt.body, 0);
+            walk_push(s, &node->data.while_stmt.cond, 0);
+            break;
+        case NODE_FOR:
+            walk_push(s, &node->data.for_stmt.body, 0);
+            walk_push(s, &node->data.for_stmt.inc, 0);
+            walk_push(s, &node->data.for_stmt.cond, 0);
+            walk_push(s, &node->data.for_stmt.init, 0);
+            break;
+        case NODE_BLOCK:
+            for (int i = node->data.block.count - 1; i >= 0; i--)
+                walk_push(s, &node->data.block.statements[i], 0);
+            break;
+        case NODE_FUNCCALL:
+            for (int i = node->data.funccall.arg_count - 1; i >= 0; i--)
+                walk_push(s, &node->data.funccall.args[i], 0);
+            break;
+        case NODE_ARRAY_DECL:
+            walk_push(s, &node->data.array_decl.size, 0);
+            break;
+        case NODE_INDEX:
+            walk_push(s, &node->data.index.index, 0);
+            break;
+        case NODE_INDEX_ASSIGN:
+            walk_push(s, &node->data.index_assign.expr, 0);
+            walk_push(s, &node->data.index_assign.index, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+// --- Runtime variables ---
+int eval_expr(ASTNode *node);
+int get_var(const char *name);
+void set_var(const char *name, int value);
+int lookup_var(const char *name, int *value);
+int *lookup_array(const char *name, int *length);
 
 #endif
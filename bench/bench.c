@@ -0,0 +1,130 @@
+// Benchmark harness: times each compiler phase on one source file.
+//
+// Usage: bench_harness <file> [reps] [name]
+//
+// Each repetition lexes the file, then parses it again from scratch and runs
+// optimise_ast(), generate_intermediate_code() and interpret() on the fresh
+// tree. Program output goes to /dev/null; one JSON object per phase is
+// written to the original stdout. The parse phase includes lexing, since
+// yyparse() pulls tokens on demand; subtract the lex phase for parser cost.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../ast.h"
+#include "../lexer.h"
+#include "../parser.tab.h"
+
+extern int yyparse();
+extern ASTNode *root;
+extern char parse_error[];
+
+enum { PHASE_LEX, PHASE_PARSE, PHASE_OPTIMISE, PHASE_IR, PHASE_INTERPRET, PHASE_COUNT };
+static const char *phase_names[PHASE_COUNT] = { "lex", "parse", "optimise", "ir", "interpret" };
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void open_source(const char *path) {
+    if (!lex_open_file(path)) {
+        perror("fopen");
+        exit(1);
+    }
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void report(FILE *out, const char *name, const char *phase, double *samples, int n, long bytes) {
+    double sum = 0, var = 0;
+    for (int i = 0; i < n; i++) sum += samples[i];
+    double mean = sum / n;
+    for (int i = 0; i < n; i++) var += (samples[i] - mean) * (samples[i] - mean);
+    double stddev = n > 1 ? sqrt(var / (n - 1)) : 0;
+    qsort(samples, n, sizeof(double), cmp_double);
+    double median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    fprintf(out, "{\"workload\": \"%s\", \"phase\": \"%s\", \"reps\": %d, "
+                 "\"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, \"stddev_ms\": %.4f, "
+                 "\"max_ms\": %.4f, \"bytes\": %ld}\n",
+            name, phase, n, samples[0], median, mean, stddev, samples[n - 1], bytes);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file> [reps] [name]\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[1];
+    int reps = argc > 2 ? atoi(argv[2]) : 5;
+    const char *name = argc > 3 ? argv[3] : path;
+    if (reps < 1) reps = 1;
+
+    // Keep the real stdout for results and silence the program itself.
+    FILE *out = fdopen(dup(STDOUT_FILENO), "w");
+    int devnull = open("/dev/null", O_WRONLY);
+    if (!out || devnull < 0) {
+        perror("bench");
+        return 1;
+    }
+    fflush(stdout);
+    dup2(devnull, STDOUT_FILENO);
+    close(devnull);
+
+    double *samples[PHASE_COUNT];
+    for (int p = 0; p < PHASE_COUNT; p++)
+        samples[p] = malloc(sizeof(double) * reps);
+
+    long bytes = 0;
+    for (int r = 0; r < reps; r++) {
+        open_source(path);
+        double t0 = now_ms();
+        while (yylex() != 0)
+            ;
+        samples[PHASE_LEX][r] = now_ms() - t0;
+        size_t len;
+        lex_input(&len);
+        bytes = (long)len;
+
+        open_source(path);
+        root = NULL;
+        t0 = now_ms();
+        if (yyparse() != 0 || !root) {
+            fprintf(stderr, "bench: failed to parse %s: %s\n", path, parse_error);
+            return 1;
+        }
+        samples[PHASE_PARSE][r] = now_ms() - t0;
+        lex_close();
+
+        t0 = now_ms();
+        optimise_ast(root);
+        samples[PHASE_OPTIMISE][r] = now_ms() - t0;
+
+        t0 = now_ms();
+        generate_intermediate_code(root);
+        fflush(stdout);
+        samples[PHASE_IR][r] = now_ms() - t0;
+
+        t0 = now_ms();
+        interpret(root);
+        fflush(stdout);
+        samples[PHASE_INTERPRET][r] = now_ms() - t0;
+
+        reset_runtime();
+        free_ast(root);
+    }
+
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        report(out, name, phase_names[p], samples[p], reps, bytes);
+        free(samples[p]);
+    }
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,110 @@
+"""Workload generator for the mini compiler benchmarks.
+
+Each generator returns the source text of a program whose size grows
+linearly with `scale`. Variable names come from a small fixed pool, so a
+larger scale means more statements, not more distinct names.
+"""
+import argparse
+import os
+
+VAR_POOL = 32
+
+
+def straight_line(scale):
+    """Long run of assignments with no control flow."""
+    lines = ["v%d = %d;" % (i, i) for i in range(VAR_POOL)]
+    for i in range(20000 * scale):
+        dst = i % VAR_POOL
+        a = (i * 7 + 3) % VAR_POOL
+        b = (i * 13 + 5) % VAR_POOL
+        lines.append("v%d = v%d + v%d * %d - %d;" % (dst, a, b, i % 9 + 1, i % 5))
+    lines += ["print v%d;" % i for i in range(VAR_POOL)]
+    return "\n".join(lines) + "\n"
+
+
+def nested_loops(scale):
+    """Perfectly nested for loops, two iterations per level."""
+    depth = 10 + scale
+    lines = ["count = 0;"]
+    for d in range(depth):
+        lines.append("%sfor (i%d = 0; i%d < 2; i%d = i%d + 1) {" % ("    " * d, d, d, d, d))
+    lines.append("%scount = count + 1;" % ("    " * depth))
+    for d in reversed(range(depth)):
+        lines.append("%s}" % ("    " * d))
+    lines.append("print count;")
+    return "\n".join(lines) + "\n"
+
+
+def many_functions(scale):
+    """Thousands of small functions, each called once."""
+    n = 2000 * scale
+    lines = []
+    for i in range(n):
+        lines.append("func f%d(x, y) {\n    r = x * %d + y;\n    return;\n}" % (i, i % 17 + 1))
+    lines.append("r = 0;")
+    for i in range(n):
+        lines.append("f%d(%d, r);" % (i, i))
+    lines.append("print r;")
+    return "\n".join(lines) + "\n"
+
+
+def wide_expression(scale):
+    """A handful of assignments whose right-hand sides have thousands of terms."""
+    terms = 2000 * scale
+    lines = ["v%d = %d;" % (i, i + 1) for i in range(VAR_POOL)]
+    for k in range(4):
+        rhs = " + ".join("v%d * %d" % (i % VAR_POOL, i % 7 + 1) for i in range(terms))
+        lines.append("w%d = %s;" % (k, rhs))
+        lines.append("print w%d;" % k)
+    return "\n".join(lines) + "\n"
+
+
+def reduction(scale):
+    """Million-iteration sum reduction, as repeated sums of 1..65000 so the
+    total always fits in an int."""
+    rounds = 15 * scale
+    return ("for (k = 0; k < %d; k = k + 1) {\n"
+            "    total = 0;\n"
+            "    for (j = 1; j <= 65000; j = j + 1) {\n"
+            "        total = total + j;\n"
+            "    }\n"
+            "}\n"
+            "print total;\n" % rounds)
+
+
+WORKLOADS = {
+    "straight_line": straight_line,
+    "nested_loops": nested_loops,
+    "many_functions": many_functions,
+    "wide_expression": wide_expression,
+    "reduction": reduction,
+}
+
+
+def write_workloads(directory, scale, names=None):
+    """Write each selected workload to <directory>/<name>.txt and return the paths."""
+    os.makedirs(directory, exist_ok=True)
+    paths = {}
+    for name in names or WORKLOADS:
+        path = os.path.join(directory, name + ".txt")
+        with open(path, "w") as f:
+            f.write(WORKLOADS[name](scale))
+        paths[name] = path
+    return paths
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate benchmark programs.")
+    parser.add_argument("--dir", default="bench/workloads")
+    parser.add_argument("--scale", type=int, default=1)
+    parser.add_argument("workloads", nargs="*", help="subset of: " + ", ".join(WORKLOADS))
+    args = parser.parse_args()
+    unknown = [w for w in args.workloads if w not in WORKLOADS]
+    if unknown:
+        parser.error("unknown workload(s): " + ", ".join(unknown))
+    for name, path in write_workloads(args.dir, args.scale, args.workloads).items():
+        print("%s -> %s" % (name, path))
+
+
+if __name__ == "__main__":
+    main()
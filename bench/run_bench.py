@@ -0,0 +1,112 @@
+"""Run the benchmark suite and optionally compare against a saved baseline.
+
+    python3 bench/run_bench.py                      # run, write bench/results.json
+    python3 bench/run_bench.py --save-baseline      # also copy results to the baseline
+    python3 bench/run_bench.py --compare            # run, then flag regressions
+    python3 bench/run_bench.py --compare-only       # compare existing results only
+
+A phase regresses when its median grows by more than --threshold (relative)
+and by more than --min-delta-ms (absolute, to ignore timer noise). The exit
+status is 1 when any regression is found.
+"""
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from gen_workload import WORKLOADS, write_workloads  # noqa: E402
+
+
+def run_suite(args):
+    paths = write_workloads(args.workdir, args.scale, args.workloads)
+    results = []
+    for name, path in paths.items():
+        proc = subprocess.run([args.harness, path, str(args.reps), name],
+                              capture_output=True, text=True)
+        if proc.returncode != 0:
+            sys.stderr.write("%s failed:\n%s" % (name, proc.stderr))
+            sys.exit(2)
+        for line in proc.stdout.splitlines():
+            rec = json.loads(line)
+            results.append(rec)
+            mbs = ""
+            if rec["phase"] == "lex" and rec["median_ms"] > 0:
+                mbs = "  %8.1f MB/s" % (rec["bytes"] / 1e6 / (rec["median_ms"] / 1e3))
+            print("%-16s %-10s median %10.3f ms  min %10.3f ms  sd %8.3f ms%s"
+                  % (name, rec["phase"], rec["median_ms"], rec["min_ms"], rec["stddev_ms"], mbs))
+    doc = {"scale": args.scale, "reps": args.reps, "results": results}
+    with open(args.out, "w") as f:
+        json.dump(doc, f, indent=2)
+    print("results written to %s" % args.out)
+    return doc
+
+
+def compare(current, baseline, threshold, min_delta):
+    base = {(r["workload"], r["phase"]): r for r in baseline["results"]}
+    regressions = 0
+    for rec in current["results"]:
+        old = base.get((rec["workload"], rec["phase"]))
+        if not old:
+            continue
+        delta = rec["median_ms"] - old["median_ms"]
+        ratio = delta / old["median_ms"] if old["median_ms"] > 0 else 0.0
+        status = "ok"
+        if ratio > threshold and delta > min_delta:
+            status = "REGRESSION"
+            regressions += 1
+        elif -ratio > threshold and -delta > min_delta:
+            status = "improved"
+        print("%-16s %-10s %10.3f -> %10.3f ms  %+7.1f%%  %s"
+              % (rec["workload"], rec["phase"], old["median_ms"], rec["median_ms"], ratio * 100, status))
+    if current.get("scale") != baseline.get("scale"):
+        print("warning: baseline was recorded at scale %s, current run is scale %s"
+              % (baseline.get("scale"), current.get("scale")))
+    print("%d regression(s)" % regressions)
+    return regressions
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Mini compiler benchmark suite.")
+    parser.add_argument("--harness", default=os.path.join(here, "bench_harness"))
+    parser.add_argument("--workdir", default=os.path.join(here, "workloads"))
+    parser.add_argument("--out", default=os.path.join(here, "results.json"))
+    parser.add_argument("--baseline", default=os.path.join(here, "baseline.json"))
+    parser.add_argument("--scale", type=int, default=1)
+    parser.add_argument("--reps", type=int, default=5)
+    parser.add_argument("--threshold", type=float, default=0.10)
+    parser.add_argument("--min-delta-ms", type=float, default=0.5)
+    parser.add_argument("--save-baseline", action="store_true")
+    parser.add_argument("--compare", action="store_true")
+    parser.add_argument("--compare-only", action="store_true")
+    parser.add_argument("workloads", nargs="*", help="subset of: " + ", ".join(WORKLOADS))
+    args = parser.parse_args()
+    unknown = [w for w in args.workloads if w not in WORKLOADS]
+    if unknown:
+        parser.error("unknown workload(s): " + ", ".join(unknown))
+
+    if args.compare_only:
+        with open(args.out) as f:
+            current = json.load(f)
+    else:
+        current = run_suite(args)
+
+    if args.save_baseline:
+        shutil.copyfile(args.out, args.baseline)
+        print("baseline saved to %s" % args.baseline)
+
+    if args.compare or args.compare_only:
+        if not os.path.exists(args.baseline):
+            sys.stderr.write("no baseline at %s (run with --save-baseline first)\n" % args.baseline)
+            sys.exit(2)
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if compare(current, baseline, args.threshold, args.min_delta_ms):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,454 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cache.h"
+#include "vectorize.h"
+#include "parallel.h"
+#include "passes.h"
+
+// --- On-disk format ---
+// header | DiskNode[node_count] | uint32 list[list_count] | strings
+// All references are 32-bit indices into one of the three sections, so the
+// file can be mapped at any address. CACHE_NONE marks a missing child.
+#define CACHE_MAGIC "MCCA"
+#define CACHE_VERSION 2
+#define CACHE_NONE 0xFFFFFFFFu
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t source_hash;
+    uint32_t node_count;
+    uint32_t list_count;
+    uint32_t string_bytes;
+    uint32_t root;
+} CacheHeader;
+
+typedef struct {
+    uint8_t type;
+    char op[3];
+    int32_t line;
+    uint32_t a, b, c, d;
+} DiskNode;
+
+static uint64_t fnv1a(uint64_t h, const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t cache_hash_source(const char *src, size_t len) {
+    return fnv1a(1469598103934665603ULL, src, len);
+}
+
+static char *cache_file_path(const char *cache_dir, const char *source_path) {
+    char resolved[4096];
+    const char *key = realpath(source_path, resolved) ? resolved : source_path;
+    uint64_t h = fnv1a(1469598103934665603ULL, key, strlen(key));
+    size_t n = strlen(cache_dir) + 32;
+    char *path = malloc(n);
+    snprintf(path, n, "%s/%016llx.mcc", cache_dir, (unsigned long long)h);
+    return path;
+}
+
+// --- Writer ---
+typedef struct {
+    DiskNode *nodes;
+    uint32_t node_count, node_cap;
+    uint32_t *lists;
+    uint32_t list_count, list_cap;
+    char *strings;
+    uint32_t string_bytes, string_cap;
+    uint32_t *interned; // open-addressing table of string offsets (+1, 0 = empty)
+    uint32_t intern_cap, intern_used;
+} Writer;
+
+static uint32_t intern_string(Writer *w, const char *s) {
+    size_t len = strlen(s);
+    if (w->intern_used * 2 >= w->intern_cap) {
+        uint32_t old_cap = w->intern_cap;
+        uint32_t *old = w->interned;
+        w->intern_cap = old_cap ? old_cap * 2 : 64;
+        w->interned = calloc(w->intern_cap, sizeof(uint32_t));
+        for (uint32_t i = 0; i < old_cap; i++) {
+            if (!old[i]) continue;
+            const char *t = w->strings + old[i] - 1;
+            uint32_t j = fnv1a(1469598103934665603ULL, t, strlen(t)) & (w->intern_cap - 1);
+            while (w->interned[j]) j = (j + 1) & (w->intern_cap - 1);
+            w->interned[j] = old[i];
+        }
+        free(old);
+    }
+    uint32_t i = fnv1a(1469598103934665603ULL, s, len) & (w->intern_cap - 1);
+    while (w->interned[i]) {
+        if (strcmp(w->strings + w->interned[i] - 1, s) == 0)
+            return w->interned[i] - 1;
+        i = (i + 1) & (w->intern_cap - 1);
+    }
+    if (w->string_bytes + len + 1 > w->string_cap) {
+        w->string_cap = (w->string_bytes + len + 1) * 2;
+        w->strings = realloc(w->strings, w->string_cap);
+    }
+    uint32_t off = w->string_bytes;
+    memcpy(w->strings + off, s, len + 1);
+    w->string_bytes += len + 1;
+    w->interned[i] = off + 1;
+    w->intern_used++;
+    return off;
+}
+
+static uint32_t reserve_node(Writer *w) {
+    if (w->node_count == w->node_cap) {
+        w->node_cap = w->node_cap ? w->node_cap * 2 : 256;
+        w->nodes = realloc(w->nodes, sizeof(DiskNode) * w->node_cap);
+    }
+    memset(&w->nodes[w->node_count], 0, sizeof(DiskNode));
+    return w->node_count++;
+}
+
+static uint32_t reserve_list(Writer *w, int count) {
+    if (w->list_count + count > w->list_cap) {
+        w->list_cap = (w->list_count + count) * 2;
+        w->lists = realloc(w->lists, sizeof(uint32_t) * w->list_cap);
+    }
+    uint32_t base = w->list_count;
+    w->list_count += count;
+    return base;
+}
+
+// Nodes are laid out in preorder, as a recursive walk would, but from the
+// shared walk stack. Each entry's state says where the child's index gets
+// patched in: field f (0-3 for a-d) of node p is FIELD_REF(p, f), entry k of
+// the list section is k, and the root has nowhere to go.
+#define ROOT_REF (-1L)
+#define FIELD_REF(p, f) (-2L - ((long)(p) * 4 + (f)))
+
+static uint32_t emit_tree(Writer *w, ASTNode *root) {
+    uint32_t root_idx = CACHE_NONE;
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &root, ROOT_REF);
+    while (s.count) {
+        WalkItem item = s.items[--s.count];
+        ASTNode *node = item.node;
+        uint32_t idx = reserve_node(w);
+        if (item.state == ROOT_REF) {
+            root_idx = idx;
+        } else if (item.state >= 0) {
+            w->lists[item.state] = idx;
+        } else {
+            long ref = -2 - item.state;
+            DiskNode *parent = &w->nodes[ref / 4];
+            uint32_t *fields[] = { &parent->a, &parent->b, &parent->c, &parent->d };
+            *fields[ref % 4] = idx;
+        }
+        // Children are pushed last to first
+        DiskNode d = { .type = (uint8_t)node->type, .line = node->line,
+                       .a = CACHE_NONE, .b = CACHE_NONE, .c = CACHE_NONE, .d = CACHE_NONE };
+        switch (node->type) {
+            case NODE_NUM:
+                d.a = (uint32_t)node->data.num_val;
+                break;
+            case NODE_ID:
+                d.a = intern_string(w, node->data.id_name);
+                break;
+            case NODE_BINOP:
+                memcpy(d.op, node->data.binop.op, sizeof(d.op));
+                walk_push(&s, &node->data.binop.right, FIELD_REF(idx, 1));
+                walk_push(&s, &node->data.binop.left, FIELD_REF(idx, 0));
+                break;
+            case NODE_ASSIGN:
+                d.a = intern_string(w, node->data.assign.id);
+                walk_push(&s, &node->data.assign.expr, FIELD_REF(idx, 1));
+                break;
+            case NODE_RETURN:
+                walk_push(&s, &node->data.ret.expr, FIELD_REF(idx, 0));
+                break;
+            case NODE_IF:
+                walk_push(&s, &node->data.if_stmt.else_branch, FIELD_REF(idx, 2));
+                walk_push(&s, &node->data.if_stmt.then_branch, FIELD_REF(idx, 1));
+                walk_push(&s, &node->data.if_stmt.cond, FIELD_REF(idx, 0));
+                break;
+            case NODE_WHILE:
+                walk_push(&s, &node->data.while_stmt.body, FIELD_REF(idx, 1));
+                walk_push(&s, &node->data.while_stmt.cond, FIELD_REF(idx, 0));
+                break;
+            case NODE_FOR:
+                walk_push(&s, &node->data.for_stmt.body, FIELD_REF(idx, 3));
+                walk_push(&s, &node->data.for_stmt.inc, FIELD_REF(idx, 2));
+                walk_push(&s, &node->data.for_stmt.cond, FIELD_REF(idx, 1));
+                walk_push(&s, &node->data.for_stmt.init, FIELD_REF(idx, 0));
+                break;
+            case NODE_BLOCK:
+                d.a = reserve_list(w, node->data.block.count);
+                d.b = node->data.block.count;
+                for (int i = node->data.block.count - 1; i >= 0; i--) {
+                    w->lists[d.a + i] = CACHE_NONE;
+                    walk_push(&s, &node->data.block.statements[i], d.a + i);
+                }
+                break;
+            case NODE_PRINT:
+                d.a = intern_string(w, node->data.print_stmt.id);
+                break;
+            case NODE_FUNCDEF:
+                d.a = intern_string(w, node->data.funcdef.name);
+                d.b = reserve_list(w, node->data.funcdef.param_count);
+                d.c = node->data.funcdef.param_count;
+                for (int i = 0; i < node->data.funcdef.param_count; i++) {
+                    uint32_t param = intern_string(w, node->data.funcdef.params[i]);
+                    w->lists[d.b + i] = param;
+                }
+                walk_push(&s, &node->data.funcdef.body, FIELD_REF(idx, 3));
+                break;
+            case NODE_FUNCCALL:
+                d.a = intern_string(w, node->data.funccall.name);
+                d.b = reserve_list(w, node->data.funccall.arg_count);
+                d.c = node->data.funccall.arg_count;
+                for (int i = node->data.funccall.arg_count - 1; i >= 0; i--) {
+                    w->lists[d.b + i] = CACHE_NONE;
+                    walk_push(&s, &node->data.funccall.args[i], d.b + i);
+                }
+                break;
+            case NODE_BREAK:
+                break;
+            case NODE_ARRAY_DECL:
+                d.a = intern_string(w, node->data.array_decl.name);
+                walk_push(&s, &node->data.array_decl.size, FIELD_REF(idx, 1));
+                break;
+            case NODE_INDEX:
+                d.a = intern_string(w, node->data.index.name);
+                walk_push(&s, &node->data.index.index, FIELD_REF(idx, 1));
+                break;
+            case NODE_INDEX_ASSIGN:
+                d.a = intern_string(w, node->data.index_assign.name);
+                walk_push(&s, &node->data.index_assign.expr, FIELD_REF(idx, 2));
+                walk_push(&s, &node->data.index_assign.index, FIELD_REF(idx, 1));
+                break;
+        }
+        w->nodes[idx] = d;
+    }
+    walk_done(&s);
+    return root_idx;
+}
+
+int cache_store(const char *cache_dir, const char *source_path, uint64_t source_hash, ASTNode *root) {
+    if (mkdir(cache_dir, 0755) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        return 0;
+    }
+    Writer w = {0};
+    CacheHeader h;
+    memcpy(h.magic, CACHE_MAGIC, 4);
+    h.version = CACHE_VERSION;
+    h.source_hash = source_hash;
+    h.root = emit_tree(&w, root);
+    h.node_count = w.node_count;
+    h.list_count = w.list_count;
+    h.string_bytes = w.string_bytes;
+
+    char *path = cache_file_path(cache_dir, source_path);
+    size_t tmp_len = strlen(path) + 32;
+    char *tmp = malloc(tmp_len);
+    snprintf(tmp, tmp_len, "%s.%d.tmp", path, (int)getpid());
+
+    int ok = 0;
+    FILE *f = fopen(tmp, "wb");
+    if (f) {
+        ok = fwrite(&h, sizeof(h), 1, f) == 1
+            && fwrite(w.nodes, sizeof(DiskNode), w.node_count, f) == w.node_count
+            && fwrite(w.lists, sizeof(uint32_t), w.list_count, f) == w.list_count
+            && fwrite(w.strings, 1, w.string_bytes, f) == w.string_bytes;
+        ok = (fclose(f) == 0) && ok;
+        ok = ok && rename(tmp, path) == 0;
+        if (!ok) unlink(tmp);
+    }
+    if (!ok) perror("cache");
+
+    free(tmp);
+    free(path);
+    free(w.nodes);
+    free(w.lists);
+    free(w.strings);
+    free(w.interned);
+    return ok;
+}
+
+// --- Loader ---
+int cache_load(const char *cache_dir, const char *source_path, uint64_t source_hash, CacheImage *img) {
+    memset(img, 0, sizeof(*img));
+    char *path = cache_file_path(cache_dir, source_path);
+    int fd = open(path, O_RDONLY);
+    free(path);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CacheHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    const CacheHeader *h = map;
+    size_t expected = sizeof(CacheHeader) + (size_t)h->node_count * sizeof(DiskNode)
+                    + (size_t)h->list_count * sizeof(uint32_t) + h->string_bytes;
+    if (memcmp(h->magic, CACHE_MAGIC, 4) != 0 || h->version != CACHE_VERSION
+        || h->source_hash != source_hash || expected != (size_t)st.st_size
+        || h->root >= h->node_count) {
+        munmap(map, st.st_size);
+        return 0;
+    }
+    const DiskNode *dn = (const DiskNode *)(h + 1);
+    const uint32_t *lists = (const uint32_t *)(dn + h->node_count);
+    const char *strings = (const char *)(lists + h->list_count);
+    if (h->string_bytes && strings[h->string_bytes - 1] != '\0') {
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    // One allocation for every node and child list in the program.
+    ASTNode *nodes = malloc(sizeof(ASTNode) * h->node_count + sizeof(void *) * h->list_count);
+    void **ptrs = (void **)(nodes + h->node_count);
+    uint32_t n = h->node_count;
+    int valid = 1;
+
+    // The writer emits nodes in preorder, so every child comes after its
+    // parent; anything else (a self or back reference) would make a cycle.
+    // CHILD_REF is for children the node cannot do without.
+#define CHILD_REF(k) ((k) != CACHE_NONE && (k) > i && (k) < n ? &nodes[k] : (valid = 0, (ASTNode *)NULL))
+#define NODE_REF(k) ((k) == CACHE_NONE ? NULL : CHILD_REF(k))
+#define STRING_REF(i) ((i) < h->string_bytes ? (char *)strings + (i) : (valid = 0, (char *)""))
+#define LIST_OK(base, count) ((uint64_t)(base) + (count) <= h->list_count)
+
+    for (uint32_t i = 0; i < n && valid; i++) {
+        const DiskNode *d = &dn[i];
+        ASTNode *node = &nodes[i];
+        node->type = (NodeType)d->type;
+        node->line = d->line;
+        switch (node->type) {
+            case NODE_NUM:
+                node->data.num_val = (int)d->a;
+                break;
+            case NODE_ID:
+                node->data.id_name = STRING_REF(d->a);
+                break;
+            case NODE_BINOP:
+                memcpy(node->data.binop.op, d->op, sizeof(d->op));
+                node->data.binop.op[sizeof(node->data.binop.op) - 1] = '\0';
+                node->data.binop.left = CHILD_REF(d->a);
+                node->data.binop.right = CHILD_REF(d->b);
+                break;
+            case NODE_ASSIGN:
+                node->data.assign.id = STRING_REF(d->a);
+                node->data.assign.expr = CHILD_REF(d->b);
+                break;
+            case NODE_RETURN:
+                node->data.ret.expr = NODE_REF(d->a);
+                break;
+            case NODE_IF:
+                node->data.if_stmt.cond = CHILD_REF(d->a);
+                node->data.if_stmt.then_branch = CHILD_REF(d->b);
+                node->data.if_stmt.else_branch = NODE_REF(d->c);
+                break;
+            case NODE_WHILE:
+                node->data.while_stmt.cond = CHILD_REF(d->a);
+                node->data.while_stmt.body = CHILD_REF(d->b);
+                break;
+            case NODE_FOR:
+                node->data.for_stmt.init = NODE_REF(d->a);
+                node->data.for_stmt.cond = CHILD_REF(d->b);
+                node->data.for_stmt.inc = NODE_REF(d->c);
+                node->data.for_stmt.body = CHILD_REF(d->d);
+                node->data.for_stmt.vec = NULL;
+                node->data.for_stmt.par = NULL;
+                break;
+            case NODE_BLOCK:
+                if (!LIST_OK(d->a, d->b)) { valid = 0; break; }
+                node->data.block.statements = (ASTNode **)(ptrs + d->a);
+                node->data.block.count = d->b;
+                for (uint32_t k = 0; k < d->b; k++)
+                    node->data.block.statements[k] = CHILD_REF(lists[d->a + k]);
+                break;
+            case NODE_PRINT:
+                node->data.print_stmt.id = STRING_REF(d->a);
+                break;
+            case NODE_FUNCDEF:
+                if (!LIST_OK(d->b, d->c)) { valid = 0; break; }
+                node->data.funcdef.name = STRING_REF(d->a);
+                node->data.funcdef.params = (char **)(ptrs + d->b);
+                node->data.funcdef.param_count = d->c;
+                for (uint32_t k = 0; k < d->c; k++)
+                    node->data.funcdef.params[k] = STRING_REF(lists[d->b + k]);
+                node->data.funcdef.body = CHILD_REF(d->d);
+                node->data.funcdef.compiled = 0; // still needs its loop plans
+                node->data.funcdef.plan = NULL;
+                break;
+            case NODE_FUNCCALL:
+                if (!LIST_OK(d->b, d->c)) { valid = 0; break; }
+                node->data.funccall.name = STRING_REF(d->a);
+                node->data.funccall.args = (ASTNode **)(ptrs + d->b);
+                node->data.funccall.arg_count = d->c;
+                for (uint32_t k = 0; k < d->c; k++)
+                    node->data.funccall.args[k] = CHILD_REF(lists[d->b + k]);
+                break;
+            case NODE_BREAK:
+                break;
+            case NODE_ARRAY_DECL:
+                node->data.array_decl.name = STRING_REF(d->a);
+                node->data.array_decl.size = CHILD_REF(d->b);
+                break;
+            case NODE_INDEX:
+                node->data.index.name = STRING_REF(d->a);
+                node->data.index.index = CHILD_REF(d->b);
+                break;
+            case NODE_INDEX_ASSIGN:
+                node->data.index_assign.name = STRING_REF(d->a);
+                node->data.index_assign.index = CHILD_REF(d->b);
+                node->data.index_assign.expr = CHILD_REF(d->c);
+                break;
+            default:
+                valid = 0;
+                break;
+        }
+    }
+
+#undef CHILD_REF
+#undef NODE_REF
+#undef STRING_REF
+#undef LIST_OK
+
+    if (!valid) {
+        free(nodes);
+        munmap(map, st.st_size);
+        return 0;
+    }
+    img->map = map;
+    img->map_size = st.st_size;
+    img->arena = nodes;
+    img->node_count = n;
+    img->root = &nodes[h->root];
+    return 1;
+}
+
+void cache_release(CacheImage *img) {
+    ASTNode *nodes = img->arena;
+    for (unsigned i = 0; i < img->node_count; i++) {
+        if (nodes[i].type == NODE_FOR) {
+            vec_free(nodes[i].data.for_stmt.vec);
+            par_free(nodes[i].data.for_stmt.par);
+        } else if (nodes[i].type == NODE_FUNCDEF) {
+            pass_plan_release(nodes[i].data.funcdef.plan);
+        }
+    }
+    free(img->arena);
+    if (img->map) munmap(img->map, img->map_size);
+    memset(img, 0, sizeof(*img));
+}
@@ -0,0 +1,24 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ast.h"
+
+// A program loaded from the on-disk cache. The nodes live in one arena and
+// their strings point into the mapped file, so the tree must be released with
+// cache_release() rather than free_ast().
+typedef struct {
+    void *map;
+    size_t map_size;
+    void *arena;
+    unsigned node_count;
+    ASTNode *root;
+} CacheImage;
+
+uint64_t cache_hash_source(const char *src, size_t len);
+int cache_load(const char *cache_dir, const char *source_path, uint64_t source_hash, CacheImage *img);
+int cache_store(const char *cache_dir, const char *source_path, uint64_t source_hash, ASTNode *root);
+void cache_release(CacheImage *img);
+
+#endif
@@ -0,0 +1,745 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <setjmp.h>
+#include "interp.h"
+#include "passes.h"
+#include "output.h"
+#include "profile.h"
+#include "vectorize.h"
+#include "parallel.h"
+
+// --- Instances ---
+typedef struct {
+    char *name;
+    ASTNode *def;
+} FuncEntry;
+
+typedef struct {
+    char *name;
+    int value;
+    int is_global;
+    int *array; // contiguous storage for arrays, NULL for scalars
+    int length;
+} VarEntry;
+
+// One statement being executed. Nested statements are pushed rather than
+// recursed into, so a running program can be suspended between any two steps.
+typedef struct {
+    ASTNode *node;
+    int pc;  // progress through the node: next statement, loop phase, ...
+    int aux; // parameters pushed by a call
+} Frame;
+
+// An expression node waiting for its operands (state 1) or not yet begun
+typedef struct {
+    ASTNode *node;
+    int state;
+} EvalItem;
+
+struct Interp {
+    ASTNode *program;
+    InterpStatus status;
+    int started;
+
+    FuncEntry *funcs;
+    int func_count;
+    int func_capacity;
+
+    VarEntry *vars;
+    int var_count;
+    int var_capacity;
+    int in_function;
+    int break_encountered;
+
+    Frame *frames;
+    int frame_count;
+    int frame_capacity;
+
+    EvalItem *eval_items; // scratch stacks for deep expressions
+    int *eval_values;
+    int eval_capacity;
+
+    long fuel;        // remaining steps, < 0 for unlimited
+    long fuel_budget; // what interp_reset() refills it to
+    long steps;       // steps executed so far
+    size_t mem_used;
+    size_t mem_limit; // 0 for unlimited
+    jmp_buf trap;     // runtime errors unwind to interp_run()
+
+    int to_stdout;    // flush the output to stdout instead of collecting it
+    int fatal_errors; // report runtime errors and exit(1), like the compiler always did
+    int loop_plans;   // may use the vectorised and parallel loop fast paths
+    int profiled;
+    char *out;
+    size_t out_len;
+    size_t out_cap;
+    InterpOutputFn sink; // when set, out only holds text not yet delivered
+    void *sink_user;
+};
+
+// The instance behind interpret() and the other ast.h entry points
+static Interp main_interp = { .status = INTERP_READY, .fuel = -1, .to_stdout = 1, .fatal_errors = 1, .loop_plans = 1 };
+
+// Instance running on this thread; the ast.h variable accessors act on it
+static __thread Interp *cur = &main_interp;
+
+// --- Output ---
+static void charge(Interp *in, size_t bytes);
+
+static char *out_reserve(Interp *in, size_t n) {
+    if (in->out_len + n + 1 > in->out_cap) {
+        size_t cap = in->out_cap ? in->out_cap : 256;
+        while (cap < in->out_len + n + 1) cap *= 2;
+        charge(in, cap - in->out_cap);
+        in->out = realloc(in->out, cap);
+        in->out_cap = cap;
+    }
+    return in->out + in->out_len;
+}
+
+// Printing or a sink gets the text in OUTPUT_BUFFER_SIZE chunks, and
+// whatever is left when interp_run() returns, a runtime error is reported or
+// the symbol table has been dumped. Collected output is never flushed.
+static void out_flush(Interp *in) {
+    if (!in->out_len) return;
+    if (in->sink) in->sink(in->sink_user, in->out, in->out_len);
+    else if (in->to_stdout) fwrite(in->out, 1, in->out_len, stdout);
+    else return;
+    in->out_len = 0;
+}
+
+static void out_write(Interp *in, const char *text, size_t len) {
+    memcpy(out_reserve(in, len), text, len);
+    in->out_len += len;
+}
+
+static void out_str(Interp *in, const char *text) {
+    out_write(in, text, strlen(text));
+}
+
+static void out_int(Interp *in, int value) {
+    in->out_len += format_int(out_reserve(in, OUTPUT_INT_MAX), value);
+}
+
+static void out_char(Interp *in, char c) {
+    *out_reserve(in, 1) = c;
+    in->out_len++;
+}
+
+// --- Runtime errors ---
+static void runtime_error(Interp *in, InterpStatus status, const char *fmt, ...) __attribute__((noreturn));
+
+static void runtime_error(Interp *in, InterpStatus status, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    if (in->fatal_errors) {
+        out_flush(in);
+        vprintf(fmt, ap);
+        exit(1);
+    }
+    // The run is finished; let the message through whatever the limit, which
+    // still applies to the next run
+    size_t limit = in->mem_limit;
+    in->mem_limit = 0;
+    va_list copy;
+    va_copy(copy, ap);
+    int n = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    char *dst = out_reserve(in, n);
+    vsnprintf(dst, n + 1, fmt, ap);
+    in->out_len += n;
+    va_end(ap);
+    out_flush(in);
+    in->mem_limit = limit;
+    in->status = status;
+    longjmp(in->trap, 1);
+}
+
+static void charge(Interp *in, size_t bytes) {
+    in->mem_used += bytes;
+    if (in->mem_limit && in->mem_used > in->mem_limit)
+        runtime_error(in, INTERP_KILLED, "Memory limit exceeded\n");
+}
+
+// --- Function Table ---
+static void register_func(Interp *in, ASTNode *node) {
+    if (in->func_count == in->func_capacity) {
+        int capacity = in->func_capacity ? in->func_capacity * 2 : 64;
+        charge(in, sizeof(FuncEntry) * (capacity - in->func_capacity));
+        in->funcs = realloc(in->funcs, sizeof(FuncEntry) * capacity);
+        in->func_capacity = capacity;
+    }
+    in->funcs[in->func_count].name = strdup(node->data.funcdef.name);
+    in->funcs[in->func_count].def = node;
+    in->func_count++;
+}
+
+static ASTNode *find_func(Interp *in, const char *name) {
+    for (int i = 0; i < in->func_count; i++) {
+        if (strcmp(in->funcs[i].name, name) == 0)
+            return in->funcs[i].def;
+    }
+    return NULL;
+}
+
+// --- Symbol Table ---
+static void push_var(Interp *in, const char *name, int value, int is_global) {
+    if (in->var_count == in->var_capacity) {
+        int capacity = in->var_capacity ? in->var_capacity * 2 : 64;
+        charge(in, sizeof(VarEntry) * (capacity - in->var_capacity));
+        in->vars = realloc(in->vars, sizeof(VarEntry) * capacity);
+        in->var_capacity = capacity;
+    }
+    charge(in, strlen(name) + 1);
+    VarEntry *var = &in->vars[in->var_count++];
+    var->name = strdup(name);
+    var->value = value;
+    var->is_global = is_global;
+    var->array = NULL;
+    var->length = 0;
+}
+
+static void pop_vars(Interp *in, int n) {
+    for (int i = 0; i < n; i++) {
+        VarEntry *var = &in->vars[--in->var_count];
+        in->mem_used -= strlen(var->name) + 1 + sizeof(int) * (size_t)var->length;
+        free(var->name);
+        free(var->array);
+    }
+}
+
+static VarEntry *find_var(Interp *in, const char *name) {
+    for (int i = in->var_count - 1; i >= 0; i--) {
+        if (strcmp(in->vars[i].name, name) == 0)
+            return &in->vars[i];
+    }
+    return NULL;
+}
+
+static int read_var(Interp *in, const char *name) {
+    VarEntry *var = find_var(in, name);
+    if (!var)
+        runtime_error(in, INTERP_ERROR, "Undefined variable: %s\n", name);
+    if (var->array)
+        runtime_error(in, INTERP_ERROR, "Array used as a scalar: %s\n", name);
+    return var->value;
+}
+
+static void write_var(Interp *in, const char *name, int value) {
+    VarEntry *var = find_var(in, name);
+    if (!var) {
+        push_var(in, name, value, in->in_function == 0 ? 1 : 0);
+        return;
+    }
+    if (var->array)
+        runtime_error(in, INTERP_ERROR, "Cannot assign a scalar to array: %s\n", name);
+    var->value = value;
+}
+
+int get_var(const char *name) {
+    return read_var(cur, name);
+}
+
+void set_var(const char *name, int value) {
+    write_var(cur, name, value);
+}
+
+// Non-fatal lookups, used by the loop optimisers to decide whether they can run
+int lookup_var(const char *name, int *value) {
+    VarEntry *var = find_var(cur, name);
+    if (!var || var->array) return 0;
+    *value = var->value;
+    return 1;
+}
+
+int *lookup_array(const char *name, int *length) {
+    VarEntry *var = find_var(cur, name);
+    if (!var || !var->array) return NULL;
+    *length = var->length;
+    return var->array;
+}
+
+// (Re)declare an array; existing storage under the same name is replaced
+static void declare_array(Interp *in, const char *name, int length) {
+    if (length <= 0)
+        runtime_error(in, INTERP_ERROR, "Invalid array size for %s: %d\n", name, length);
+    VarEntry *var = find_var(in, name);
+    if (!var) {
+        push_var(in, name, 0, in->in_function == 0 ? 1 : 0);
+        var = &in->vars[in->var_count - 1];
+    }
+    in->mem_used -= sizeof(int) * (size_t)var->length;
+    free(var->array);
+    var->array = NULL;
+    var->length = 0;
+    charge(in, sizeof(int) * (size_t)length);
+    var->array = calloc(length, sizeof(int));
+    var->length = length;
+    var->value = 0;
+}
+
+static int *array_element(Interp *in, const char *name, int index) {
+    VarEntry *var = find_var(in, name);
+    if (!var || !var->array)
+        runtime_error(in, INTERP_ERROR, "Undefined array: %s\n", name);
+    if (index < 0 || index >= var->length)
+        runtime_error(in, INTERP_ERROR, "Array index out of bounds: %s[%d]\n", name, index);
+    return &var->array[index];
+}
+
+// The latest entry for each name is found scanning backwards with a set of
+// the names already seen, then the table is printed in its own order.
+static unsigned hash_name(const char *name) {
+    unsigned h = 2166136261u;
+    while (*name) h = (h ^ (unsigned char)*name++) * 16777619u;
+    return h;
+}
+
+static void dump_symbols(Interp *in) {
+    int n = in->var_count;
+    size_t cap = 16;
+    while (cap < (size_t)n * 2) cap *= 2;
+    const char **seen = calloc(cap, sizeof(char *));
+    char *latest = malloc(n + 1);
+    for (int i = n - 1; i >= 0; i--) {
+        const char *name = in->vars[i].name;
+        size_t slot = hash_name(name) & (cap - 1);
+        while (seen[slot] && strcmp(seen[slot], name) != 0)
+            slot = (slot + 1) & (cap - 1);
+        latest[i] = !seen[slot];
+        seen[slot] = name;
+    }
+    out_str(in, "\n--- Symbol Table ---\n");
+    for (int i = 0; i < n; i++) {
+        if (!latest[i] || !in->vars[i].is_global) continue;
+        out_str(in, in->vars[i].name);
+        if (in->vars[i].array) {
+            out_str(in, " = array[");
+            out_int(in, in->vars[i].length);
+            out_str(in, "]\n");
+        } else {
+            out_str(in, " = ");
+            out_int(in, in->vars[i].value);
+            out_char(in, '\n');
+        }
+    }
+    free(seen);
+    free(latest);
+    out_flush(in);
+}
+
+void print_symbol_table(void) {
+    dump_symbols(&main_interp);
+}
+
+// Drop all variables and registered functions so a program can be run again
+void reset_runtime(void) {
+    Interp *in = &main_interp;
+    pop_vars(in, in->var_count);
+    for (int i = 0; i < in->func_count; i++)
+        free(in->funcs[i].name);
+    in->func_count = 0;
+    in->frame_count = 0;
+    in->in_function = 0;
+    in->break_encountered = 0;
+}
+
+// --- Evaluation ---
+static int apply_binop(Interp *in, const char *op, int l, int r) {
+    if (strcmp(op, "+") == 0) return l + r;
+    if (strcmp(op, "-") == 0) return l - r;
+    if (strcmp(op, "*") == 0) return l * r;
+    if (strcmp(op, "/") == 0) {
+        if (r == 0) runtime_error(in, INTERP_ERROR, "Division by zero\n");
+        if (l == INT_MIN && r == -1) runtime_error(in, INTERP_ERROR, "Division overflow\n");
+        return l / r;
+    }
+    if (strcmp(op, "==") == 0) return l == r;
+    if (strcmp(op, "!=") == 0) return l != r;
+    if (strcmp(op, "<") == 0) return l < r;
+    if (strcmp(op, "<=") == 0) return l <= r;
+    if (strcmp(op, ">") == 0) return l > r;
+    if (strcmp(op, ">=") == 0) return l >= r;
+    runtime_error(in, INTERP_ERROR, "Unsupported expr\n");
+}
+
+// Post-order over an explicit stack, so operator chains of any length run in
+// bounded C stack. Operands are evaluated left to right, as before.
+static int eval_nested(Interp *in, ASTNode *node) {
+    int items = 0, values = 0;
+    in->eval_items[items++] = (EvalItem){ node, 0 };
+    while (items) {
+        // Each step pushes at most three items or one value
+        if (items + 3 > in->eval_capacity || values + 1 > in->eval_capacity) {
+            int capacity = in->eval_capacity * 2;
+            charge(in, (sizeof(EvalItem) + sizeof(int)) * (capacity - in->eval_capacity));
+            in->eval_items = realloc(in->eval_items, sizeof(EvalItem) * capacity);
+            in->eval_values = realloc(in->eval_values, sizeof(int) * capacity);
+            in->eval_capacity = capacity;
+        }
+        EvalItem item = in->eval_items[--items];
+        ASTNode *n = item.node;
+        if (item.state) {
+            if (n->type == NODE_INDEX) {
+                int *slot = &in->eval_values[values - 1];
+                *slot = *array_element(in, n->data.index.name, *slot);
+            } else {
+                int r = in->eval_values[--values];
+                int *slot = &in->eval_values[values - 1];
+                *slot = apply_binop(in, n->data.binop.op, *slot, r);
+            }
+            continue;
+        }
+        switch (n->type) {
+            case NODE_NUM:
+                in->eval_values[values++] = n->data.num_val;
+                break;
+            case NODE_ID:
+                in->eval_values[values++] = read_var(in, n->data.id_name);
+                break;
+            case NODE_INDEX:
+                in->eval_items[items++] = (EvalItem){ n, 1 };
+                in->eval_items[items++] = (EvalItem){ n->data.index.index, 0 };
+                break;
+            case NODE_BINOP:
+                in->eval_items[items++] = (EvalItem){ n, 1 };
+                in->eval_items[items++] = (EvalItem){ n->data.binop.right, 0 };
+                in->eval_items[items++] = (EvalItem){ n->data.binop.left, 0 };
+                break;
+            default:
+                runtime_error(in, INTERP_ERROR, "Unsupported expr\n");
+        }
+    }
+    return in->eval_values[0];
+}
+
+static int eval(Interp *in, ASTNode *node) {
+    switch (node->type) {
+        case NODE_NUM: return node->data.num_val;
+        case NODE_ID: return read_var(in, node->data.id_name);
+        case NODE_BINOP: {
+            // Most operators combine two leaves; skip the stacks for those
+            ASTNode *l = node->data.binop.left;
+            ASTNode *r = node->data.binop.right;
+            if ((l->type == NODE_NUM || l->type == NODE_ID) && (r->type == NODE_NUM || r->type == NODE_ID)) {
+                int lv = l->type == NODE_NUM ? l->data.num_val : read_var(in, l->data.id_name);
+                int rv = r->type == NODE_NUM ? r->data.num_val : read_var(in, r->data.id_name);
+                return apply_binop(in, node->data.binop.op, lv, rv);
+            }
+            break;
+        }
+        case NODE_INDEX: break;
+        default: runtime_error(in, INTERP_ERROR, "Unsupported expr\n");
+    }
+    if (!in->eval_capacity) {
+        in->eval_capacity = 64;
+        charge(in, (sizeof(EvalItem) + sizeof(int)) * in->eval_capacity);
+        in->eval_items = malloc(sizeof(EvalItem) * in->eval_capacity);
+        in->eval_values = malloc(sizeof(int) * in->eval_capacity);
+    }
+    return eval_nested(in, node);
+}
+
+int eval_expr(ASTNode *node) {
+    return eval(cur, node);
+}
+
+// --- Interpretation ---
+static void push_frame(Interp *in, ASTNode *node) {
+    if (!node) return;
+    if (in->frame_count == in->frame_capacity) {
+        int capacity = in->frame_capacity ? in->frame_capacity * 2 : 64;
+        charge(in, sizeof(Frame) * (capacity - in->frame_capacity));
+        in->frames = realloc(in->frames, sizeof(Frame) * capacity);
+        in->frame_capacity = capacity;
+    }
+    Frame *f = &in->frames[in->frame_count++];
+    f->node = node;
+    f->pc = 0;
+    f->aux = 0;
+    if (in->profiled) profile_enter(node);
+}
+
+static void pop_frame(Interp *in) {
+    in->frame_count--;
+    if (in->profiled) profile_exit();
+}
+
+// Run the innermost statement until it finishes or needs a nested statement
+// executed first. Frames may move when a child is pushed, so f is not used
+// after push_frame().
+static void step(Interp *in) {
+    Frame *f = &in->frames[in->frame_count - 1];
+    ASTNode *node = f->node;
+    switch (node->type) {
+        case NODE_ASSIGN:
+            write_var(in, node->data.assign.id, eval(in, node->data.assign.expr));
+            break;
+        case NODE_PRINT: {
+            VarEntry *var = find_var(in, node->data.print_stmt.id);
+            if (var && var->array) {
+                for (int i = 0; i < var->length; i++) {
+                    if (i) out_char(in, ' ');
+                    out_int(in, var->array[i]);
+                }
+                out_char(in, '\n');
+            } else {
+                out_int(in, read_var(in, node->data.print_stmt.id));
+                out_char(in, '\n');
+            }
+            if (in->out_len >= OUTPUT_BUFFER_SIZE) out_flush(in);
+            break;
+        }
+        case NODE_BLOCK:
+            if (f->pc < node->data.block.count && !in->break_encountered) {
+                int i = f->pc++;
+                push_frame(in, node->data.block.statements[i]);
+                return;
+            }
+            break;
+        case NODE_WHILE:
+            // pc is 1 once the body has run
+            if (f->pc == 1 && in->break_encountered) {
+                in->break_encountered = 0;
+                break;
+            }
+            if (!eval(in, node->data.while_stmt.cond)) break;
+            if (in->profiled) profile_loop_iteration(node);
+            in->break_encountered = 0;
+            f->pc = 1;
+            push_frame(in, node->data.while_stmt.body);
+            return;
+        case NODE_FOR:
+            // pc: 0 init, 1 fast paths, 2 condition, 3 after the body
+            if (f->pc == 0) {
+                f->pc = 1;
+                push_frame(in, node->data.for_stmt.init);
+                return;
+            }
+            if (f->pc == 1) {
+                if (in->loop_plans && node->data.for_stmt.vec && vec_run(node->data.for_stmt.vec))
+                    break;
+                if (in->loop_plans && node->data.for_stmt.par && par_run(node->data.for_stmt.par))
+                    break;
+                f->pc = 2;
+            }
+            if (f->pc == 3) {
+                if (in->break_encountered) {
+                    in->break_encountered = 0;
+                    break;
+                }
+                f->pc = 2;
+                push_frame(in, node->data.for_stmt.inc);
+                return;
+            }
+            if (!eval(in, node->data.for_stmt.cond)) break;
+            if (in->profiled) profile_loop_iteration(node);
+            in->break_encountered = 0;
+            f->pc = 3;
+            push_frame(in, node->data.for_stmt.body);
+            return;
+        case NODE_IF:
+            if (f->pc == 0) {
+                f->pc = 1;
+                if (eval(in, node->data.if_stmt.cond))
+                    push_frame(in, node->data.if_stmt.then_branch);
+                else
+                    push_frame(in, node->data.if_stmt.else_branch);
+                return;
+            }
+            break;
+        case NODE_FUNCDEF:
+            register_func(in, node);
+            break;
+        case NODE_FUNCCALL: {
+            if (f->pc == 1) {
+                pop_vars(in, f->aux);
+                in->in_function--;
+                break;
+            }
+            ASTNode *func = find_func(in, node->data.funccall.name);
+            if (!func)
+                runtime_error(in, INTERP_ERROR, "Undefined function: %s\n", node->data.funccall.name);
+            compile_function(func);
+            int param_count = func->data.funcdef.param_count;
+            int arg_values[param_count + 1];
+            for (int i = 0; i < param_count; i++) {
+                arg_values[i] = eval(in, node->data.funccall.args[i]);
+            }
+            in->in_function++;
+            for (int i = 0; i < param_count; i++) {
+                push_var(in, func->data.funcdef.params[i], arg_values[i], 0);
+            }
+            f->pc = 1;
+            f->aux = param_count;
+            push_frame(in, func->data.funcdef.body);
+            return;
+        }
+        case NODE_BREAK:
+            in->break_encountered = 1;
+            break;
+        case NODE_ARRAY_DECL:
+            declare_array(in, node->data.array_decl.name, eval(in, node->data.array_decl.size));
+            break;
+        case NODE_INDEX_ASSIGN: {
+            int index = eval(in, node->data.index_assign.index);
+            int value = eval(in, node->data.index_assign.expr);
+            *array_element(in, node->data.index_assign.name, index) = value;
+            break;
+        }
+        default:
+            break;
+    }
+    pop_frame(in);
+}
+
+// Execute at most `steps` steps (all of them if steps < 0). Returns
+// INTERP_READY if the program yielded with work left.
+InterpStatus interp_run(Interp *in, long steps) {
+    if (in->status != INTERP_READY) return in->status;
+    Interp *caller = cur;
+    cur = in;
+    if (setjmp(in->trap)) {
+        if (in->profiled) {
+            while (in->frame_count) pop_frame(in);
+        }
+        cur = caller;
+        return in->status;
+    }
+    if (!in->started) {
+        in->started = 1;
+        push_frame(in, in->program);
+    }
+    for (long n = 0; in->frame_count && (steps < 0 || n < steps); n++) {
+        if (in->fuel == 0)
+            runtime_error(in, INTERP_KILLED, "Out of fuel after %ld steps\n", in->steps);
+        step(in);
+        in->steps++;
+        if (in->fuel > 0) in->fuel--;
+    }
+    if (!in->frame_count) in->status = INTERP_DONE;
+    out_flush(in);
+    cur = caller;
+    return in->status;
+}
+
+void interpret(ASTNode *node) {
+    if (!node) return;
+    main_interp.program = node;
+    main_interp.status = INTERP_READY;
+    main_interp.started = 0;
+    main_interp.profiled = profile_enabled;
+    interp_run(&main_interp, -1);
+}
+
+// --- Instance lifecycle ---
+// Separate instances collect their output, turn errors into a status and
+// skip the loop fast paths, whose work would bypass the fuel count.
+Interp *interp_new(ASTNode *program) {
+    Interp *in = calloc(1, sizeof(Interp));
+    in->program = program;
+    in->status = INTERP_READY;
+    in->fuel = -1;
+    in->fuel_budget = -1;
+    return in;
+}
+
+// Keeps the limits, options and allocated capacity, so rerunning a program
+// in the same instance allocates little beyond its variable names.
+void interp_reset(Interp *in) {
+    pop_vars(in, in->var_count);
+    for (int i = 0; i < in->func_count; i++)
+        free(in->funcs[i].name);
+    in->func_count = 0;
+    in->frame_count = 0;
+    in->in_function = 0;
+    in->break_encountered = 0;
+    in->status = INTERP_READY;
+    in->started = 0;
+    in->fuel = in->fuel_budget;
+    in->steps = 0;
+    in->out_len = 0;
+}
+
+void interp_free(Interp *in) {
+    if (!in) return;
+    pop_vars(in, in->var_count);
+    for (int i = 0; i < in->func_count; i++)
+        free(in->funcs[i].name);
+    free(in->funcs);
+    free(in->vars);
+    free(in->frames);
+    free(in->eval_items);
+    free(in->eval_values);
+    free(in->out);
+    free(in);
+}
+
+void interp_set_fuel(Interp *in, long fuel) {
+    in->fuel = fuel;
+    in->fuel_budget = fuel;
+}
+
+void interp_set_memory_limit(Interp *in, size_t bytes) {
+    in->mem_limit = bytes;
+}
+
+void interp_set_output(Interp *in, InterpOutputFn fn, void *user) {
+    in->sink = fn;
+    in->sink_user = user;
+}
+
+void interp_set_loop_plans(Interp *in, int enabled) {
+    in->loop_plans = enabled;
+}
+
+void interp_set_profiled(Interp *in, int enabled) {
+    in->profiled = enabled;
+}
+
+// Outside interp_run() nothing can catch a runtime error, so inputs are
+// neither checked against the memory limit nor allowed to replace an array.
+void interp_set_var(Interp *in, const char *name, int value) {
+    VarEntry *var = find_var(in, name);
+    if (var && var->array) return;
+    size_t limit = in->mem_limit;
+    in->mem_limit = 0;
+    if (var) var->value = value;
+    else push_var(in, name, value, 1);
+    in->mem_limit = limit;
+}
+
+int interp_get_var(const Interp *in, const char *name, int *value) {
+    VarEntry *var = find_var((Interp *)in, name);
+    if (!var || var->array) return 0;
+    *value = var->value;
+    return 1;
+}
+
+int interp_started(const Interp *in) {
+    return in->started;
+}
+
+InterpStatus interp_status(const Interp *in) {
+    return in->status;
+}
+
+// Called between runs, where nothing can catch a memory-limit error
+void interp_dump_symbols(Interp *in) {
+    size_t limit = in->mem_limit;
+    in->mem_limit = 0;
+    dump_symbols(in);
+    in->mem_limit = limit;
+}
+
+const char *interp_output(const Interp *in, size_t *len) {
+    *len = in->out_len;
+    return in->out ? in->out : "";
+}
+
+long interp_steps(const Interp *in) {
+    return in->steps;
+}
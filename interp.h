@@ -0,0 +1,45 @@
+#ifndef INTERP_H
+#define INTERP_H
+
+#include <stddef.h>
+#include "ast.h"
+
+// An isolated interpreter instance: its own variables, functions, output and
+// limits. Execution is resumable, so a scheduler can run many instances in
+// slices of at most `steps` statement steps each. The interpret(),
+// print_symbol_table() and reset_runtime() entry points in ast.h act on a
+// built-in instance that writes straight to stdout.
+typedef struct Interp Interp;
+
+typedef enum {
+    INTERP_READY,   // not started, or yielded with work left
+    INTERP_DONE,
+    INTERP_ERROR,   // runtime error; the message is in the output
+    INTERP_KILLED   // ran out of fuel or memory
+} InterpStatus;
+
+// Receives output in order, a statement at a time; text is not NUL-terminated
+typedef void (*InterpOutputFn)(void *user, const char *text, size_t len);
+
+Interp *interp_new(ASTNode *program);
+void interp_free(Interp *in);
+void interp_reset(Interp *in); // forget variables and functions, refill the fuel
+
+void interp_set_fuel(Interp *in, long fuel);            // steps per run; < 0 is unlimited
+void interp_set_memory_limit(Interp *in, size_t bytes); // 0 is unlimited
+void interp_set_output(Interp *in, InterpOutputFn fn, void *user); // NULL collects it
+void interp_set_loop_plans(Interp *in, int enabled);   // allow vectorised/parallel loops
+void interp_set_profiled(Interp *in, int enabled);     // feed the process-wide profiler
+
+// Variables of a program that has not started yet, or has finished
+void interp_set_var(Interp *in, const char *name, int value);
+int interp_get_var(const Interp *in, const char *name, int *value);
+
+InterpStatus interp_run(Interp *in, long steps);
+InterpStatus interp_status(const Interp *in);
+int interp_started(const Interp *in);
+void interp_dump_symbols(Interp *in);
+const char *interp_output(const Interp *in, size_t *len);
+long interp_steps(const Interp *in);
+
+#endif
@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "lexer.h"
+#include "parser.tab.h"
+
+// Hand-written scanner over an in-memory copy or mmap of the whole input.
+// Identifiers and numbers are returned as slices of that buffer; nothing is
+// allocated per token. Token stream and line counting match the old flex
+// rules: keywords, two-character comparisons, single-character punctuation,
+// [0-9]+ numbers, [a-zA-Z_][a-zA-Z0-9_]* identifiers, and any other byte
+// returned as itself.
+
+int yylineno = 1;
+
+static const char *input = NULL;
+static size_t input_len = 0;
+static size_t pos = 0;
+static int input_mapped = 0; // 1 = munmap on close, 2 = free on close
+
+static void free_interned(void);
+
+// --- Input ---
+void lex_close(void) {
+    free_interned();
+    if (input_mapped == 1) munmap((void *)input, input_len);
+    else if (input_mapped == 2) free((void *)input);
+    input = NULL;
+    input_len = 0;
+    input_mapped = 0;
+    pos = 0;
+}
+
+void lex_set_buffer(const char *buf, size_t len) {
+    lex_close();
+    input = buf;
+    input_len = len;
+    yylineno = 1;
+}
+
+int lex_open_stream(FILE *f) {
+    size_t cap = 1 << 16, len = 0, n;
+    char *buf = malloc(cap);
+    while ((n = fread(buf + len, 1, cap - len, f)) > 0) {
+        len += n;
+        if (len == cap) buf = realloc(buf, cap *= 2);
+    }
+    lex_set_buffer(buf, len);
+    input_mapped = 2;
+    return 1;
+}
+
+int lex_open_file(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            close(fd);
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            lex_set_buffer(map, st.st_size);
+            input_mapped = 1;
+            return 1;
+        }
+    }
+    // Pipes, empty files and anything else that cannot be mapped
+    FILE *f = fdopen(fd, "rb");
+    if (!f) {
+        close(fd);
+        return 0;
+    }
+    lex_open_stream(f);
+    fclose(f);
+    return 1;
+}
+
+const char *lex_input(size_t *len) {
+    *len = input_len;
+    return input;
+}
+
+// Contextual words such as "array" lex as identifiers; the parser checks them.
+int lex_is(Slice s, const char *word) {
+    return s.len == strlen(word) && memcmp(input + s.off, word, s.len) == 0;
+}
+
+// --- Identifier interning ---
+// The parser turns each identifier slice into a C string here, so repeated
+// names share one copy instead of a strdup per occurrence. AST constructors
+// copy the names they keep, so the table is dropped by lex_close().
+static char **interned = NULL;
+static size_t intern_cap = 0;
+static size_t intern_used = 0;
+
+static size_t hash_bytes(const char *s, size_t len) {
+    size_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static void free_interned(void) {
+    for (size_t i = 0; i < intern_cap; i++)
+        free(interned[i]);
+    free(interned);
+    interned = NULL;
+    intern_cap = 0;
+    intern_used = 0;
+}
+
+char *lex_intern(Slice s) {
+    const char *text = input + s.off;
+    if (intern_used * 2 >= intern_cap) {
+        size_t old_cap = intern_cap;
+        char **old = interned;
+        intern_cap = old_cap ? old_cap * 2 : 256;
+        interned = calloc(intern_cap, sizeof(char *));
+        for (size_t i = 0; i < old_cap; i++) {
+            if (!old[i]) continue;
+            size_t j = hash_bytes(old[i], strlen(old[i])) & (intern_cap - 1);
+            while (interned[j]) j = (j + 1) & (intern_cap - 1);
+            interned[j] = old[i];
+        }
+        free(old);
+    }
+    size_t i = hash_bytes(text, s.len) & (intern_cap - 1);
+    while (interned[i]) {
+        if (strncmp(interned[i], text, s.len) == 0 && interned[i][s.len] == '\0')
+            return interned[i];
+        i = (i + 1) & (intern_cap - 1);
+    }
+    interned[i] = strndup(text, s.len);
+    intern_used++;
+    return interned[i];
+}
+
+// --- Character classes ---
+static inline int is_digit(unsigned char c) { return c - '0' < 10u; }
+static inline int is_id_start(unsigned char c) { return ((c | 0x20) - 'a' < 26u) || c == '_'; }
+static inline int is_id_char(unsigned char c) { return is_id_start(c) || is_digit(c); }
+
+#ifdef __SSE2__
+// Bytes of v in [lo, lo + n), using the signed-compare bias trick.
+static inline __m128i in_range(__m128i v, unsigned char lo, unsigned char n) {
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(-(int)lo - 128)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(n - 128)));
+}
+#endif
+
+// Skip spaces, tabs, carriage returns and newlines, counting the newlines.
+static void skip_whitespace(void) {
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (pos + 16 <= input_len) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(input + pos));
+        __m128i is_nl = _mm_cmpeq_epi8(v, nl);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, cr), is_nl));
+        unsigned stop = ~(unsigned)_mm_movemask_epi8(ws) & 0xFFFF;
+        unsigned nl_mask = (unsigned)_mm_movemask_epi8(is_nl);
+        if (stop) {
+            int n = __builtin_ctz(stop);
+            yylineno += __builtin_popcount(nl_mask & ((1u << n) - 1));
+            pos += n;
+            return;
+        }
+        yylineno += __builtin_popcount(nl_mask);
+        pos += 16;
+    }
+#endif
+    while (pos < input_len) {
+        char c = input[pos];
+        if (c == '\n') yylineno++;
+        else if (c != ' ' && c != '\t' && c != '\r') return;
+        pos++;
+    }
+}
+
+// Advance pos past the identifier characters that follow the first one.
+static void scan_identifier_tail(void) {
+#ifdef __SSE2__
+    while (pos + 16 <= input_len) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(input + pos));
+        __m128i lower = in_range(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26);
+        __m128i digit = in_range(v, '0', 10);
+        __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+        unsigned stop = ~(unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(lower, digit), under)) & 0xFFFF;
+        if (stop) {
+            pos += __builtin_ctz(stop);
+            return;
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < input_len && is_id_char(input[pos])) pos++;
+}
+
+static int keyword(const char *s, unsigned len) {
+    switch (len) {
+        case 2:
+            if (memcmp(s, "if", 2) == 0) return IF;
+            break;
+        case 3:
+            if (memcmp(s, "for", 3) == 0) return FOR;
+            break;
+        case 4:
+            if (memcmp(s, "func", 4) == 0) return FUNC;
+            if (memcmp(s, "else", 4) == 0) return ELSE;
+            break;
+        case 5:
+            if (memcmp(s, "while", 5) == 0) return WHILE;
+            if (memcmp(s, "print", 5) == 0) return PRINT;
+            if (memcmp(s, "break", 5) == 0) return BREAK;
+            break;
+        case 6:
+            if (memcmp(s, "return", 6) == 0) return RETURN;
+            break;
+    }
+    return 0;
+}
+
+// --- Scanner ---
+int yylex(void) {
+    skip_whitespace();
+    if (pos >= input_len) return 0;
+
+    size_t start = pos;
+    unsigned char c = input[pos++];
+
+    if (is_id_start(c)) {
+        scan_identifier_tail();
+        unsigned len = pos - start;
+        int kw = keyword(input + start, len);
+        if (kw) return kw;
+        yylval.slice.off = start;
+        yylval.slice.len = len;
+        return ID;
+    }
+
+    if (is_digit(c)) {
+        // Same result as atoi(): strtol saturates, then truncates to int
+        unsigned long long value = c - '0';
+        while (pos < input_len && is_digit(input[pos])) {
+            if (value > (ULLONG_MAX - 9) / 10) value = (unsigned long long)LONG_MAX + 1;
+            else value = value * 10 + (input[pos] - '0');
+            pos++;
+        }
+        yylval.num = (int)(value > LONG_MAX ? LONG_MAX : (long)value);
+        return NUMBER;
+    }
+
+    char next = pos < input_len ? input[pos] : '\0';
+    switch (c) {
+        case '=': if (next == '=') { pos++; return EQ; } return '=';
+        case '!': if (next == '=') { pos++; return NE; } return '!';
+        case '<': if (next == '=') { pos++; return LE; } return LT;
+        case '>': if (next == '=') { pos++; return GE; } return GT;
+        default: return (char)c;
+    }
+}
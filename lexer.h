@@ -0,0 +1,24 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// A token's text as a window into the input buffer.
+typedef struct {
+    unsigned off;
+    unsigned len;
+} Slice;
+
+extern int yylineno;
+
+int lex_open_file(const char *path);
+int lex_open_stream(FILE *f);
+void lex_set_buffer(const char *buf, size_t len);
+void lex_close(void);
+const char *lex_input(size_t *len);
+int lex_is(Slice s, const char *word);
+char *lex_intern(Slice s);
+int yylex(void);
+
+#endif
@@ -1,52 +1,207 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "ast.h"
+#include "minicompiler.h"
 
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [--profile] [--profile-out FILE] [--cache | --cache-dir DIR] [--no-vectorize] [--threads N] [--par-min-trip N] [file]\n", prog);
+    fprintf(stderr, "       %s [-O0 | -O1 | -O2 | -O3] [--disable-pass NAME[,NAME...]] [--pass-stats] ...\n", prog);
+    fprintf(stderr, "       %s [--workers N] [--quantum N] [--fuel N] [--mem-limit BYTES] file...\n", prog);
+}
 
-extern int yyparse();
-extern FILE *yyin;
-extern ASTNode *root;
-extern int yylineno;
+static void write_stdout(void *user, const char *text, size_t len) {
+    (void)user;
+    fwrite(text, 1, len, stdout);
+}
 
-int main(int argc, char **argv) {
-    if (argc > 1) {
-        yyin = fopen(argv[1], "r");
-        if (!yyin) {
-            perror("fopen");
-            return 1;
+// Run a program once, printing its output and then the symbol table. A
+// runtime error ends the run after its message, as it always has.
+static int run_program(mc_program *prog, int profile, const char *folded_path) {
+    mc_context *ctx = mc_context_new(prog);
+    mc_set_output(ctx, write_stdout, NULL);
+    mc_enable_fast_loops(ctx, 1);
+    mc_enable_profile(ctx, profile);
+    mc_status status = mc_run(ctx);
+    if (status == MC_OK) {
+        mc_dump_symbols(ctx);
+        if (profile) {
+            fflush(stdout);
+            mc_profile_report(stderr, folded_path);
         }
-    } else {
-        yyin = stdin;
     }
+    mc_context_free(ctx);
+    return status == MC_OK ? 0 : 1;
+}
 
-    yylineno = 1;
-    if (yyparse() == 0) {
-        if (!root) {
-            fprintf(stderr, "Error: AST root is NULL after parsing.\n");
-            if (yyin && yyin != stdin) fclose(yyin);
-            return 2;
+static char *read_stream(FILE *f, size_t *len) {
+    size_t cap = 1 << 16, n;
+    char *buf = malloc(cap);
+    *len = 0;
+    while ((n = fread(buf + *len, 1, cap - *len, f)) > 0) {
+        *len += n;
+        if (*len == cap) buf = realloc(buf, cap *= 2);
+    }
+    return buf;
+}
+
+// Run several scripts in one process, each in its own context, interleaved
+// on a pool of worker threads. Outputs are printed in argument order once
+// everything has finished.
+static int run_isolated(const char **paths, int count, const mc_options *opts, int pass_stats,
+                        int workers, long quantum, long fuel, size_t mem_limit) {
+    mc_program **programs = calloc(count, sizeof(mc_program *));
+    mc_context **contexts = calloc(count, sizeof(mc_context *));
+    mc_scheduler *sched = mc_scheduler_new(workers, quantum);
+    char err[512];
+    for (int i = 0; i < count; i++) {
+        programs[i] = mc_compile_file(paths[i], opts, err, sizeof(err));
+        if (!programs[i]) {
+            fprintf(stderr, "%s\n", err);
+            continue;
         }
-        printf("--- Abstract Syntax Tree (AST) ---\n");
-        print_ast(root, 0);
+        contexts[i] = mc_context_new(programs[i]);
+        mc_set_fuel(contexts[i], fuel);
+        mc_set_memory_limit(contexts[i], mem_limit);
+        mc_scheduler_submit(sched, contexts[i]);
+    }
+    mc_scheduler_wait(sched);
+    mc_scheduler_free(sched);
+
+    int failed = 0;
+    for (int i = 0; i < count; i++) {
+        printf("=== %s ===\n", paths[i]);
+        if (!contexts[i]) {
+            failed = 1;
+            continue;
+        }
+        if (mc_context_status(contexts[i]) == MC_OK) mc_dump_symbols(contexts[i]);
+        else failed = 1;
+        size_t len;
+        const char *out = mc_output(contexts[i], &len);
+        fwrite(out, 1, len, stdout);
+        if (pass_stats) {
+            fflush(stdout);
+            mc_pass_report(programs[i], stderr);
+        }
+        mc_context_free(contexts[i]);
+        mc_program_free(programs[i]);
+    }
+    free(contexts);
+    free(programs);
+    return failed;
+}
 
-        // Optimise and print only optimized intermediate code
-        optimise_ast(root);
-        printf("\n--- Intermediate Code ---\n");
-        generate_intermediate_code(root);
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    const char **paths = malloc(sizeof(char *) * argc);
+    int path_count = 0;
+    const char *folded_path = "profile.folded";
+    const char *cache_dir = NULL;
+    int profile = 0;
+    int opt_level = MC_OPT_DEFAULT;
+    char *disabled = NULL; // --disable-pass arguments, joined with commas
+    size_t disabled_len = 0;
+    int pass_stats = 0;
+    int threads = 1;
+    long min_trip = 10000;
+    int workers = 4;
+    long quantum = 10000;
+    long fuel = -1;
+    size_t mem_limit = 0;
+    int status = 1;
+    mc_program *prog = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0) {
+            profile = 1;
+        } else if (strcmp(argv[i], "--profile-out") == 0 && i + 1 < argc) {
+            profile = 1;
+            folded_path = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] == 'O' && argv[i][2] >= '0' && argv[i][2] <= '3' && !argv[i][3]) {
+            opt_level = MC_OPT_O0 + (argv[i][2] - '0');
+        } else if (strcmp(argv[i], "--disable-pass") == 0 && i + 1 < argc) {
+            const char *names = argv[++i];
+            size_t len = strlen(names);
+            disabled = realloc(disabled, disabled_len + len + 2);
+            if (disabled_len) disabled[disabled_len++] = ',';
+            memcpy(disabled + disabled_len, names, len + 1);
+            disabled_len += len;
+        } else if (strcmp(argv[i], "--pass-stats") == 0) {
+            pass_stats = 1;
+        } else if (strcmp(argv[i], "--no-vectorize") == 0) {
+            mc_set_vectorize(0);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--par-min-trip") == 0 && i + 1 < argc) {
+            min_trip = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--cache") == 0) {
+            cache_dir = ".mcc_cache";
+        } else if (strcmp(argv[i], "--cache-dir") == 0 && i + 1 < argc) {
+            cache_dir = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quantum") == 0 && i + 1 < argc) {
+            quantum = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--fuel") == 0 && i + 1 < argc) {
+            fuel = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--mem-limit") == 0 && i + 1 < argc) {
+            mem_limit = strtoull(argv[++i], NULL, 10);
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            usage(argv[0]);
+            goto out;
+        } else {
+            path = argv[i];
+            paths[path_count++] = path;
+        }
+    }
+    mc_set_threads(threads, min_trip);
+    // The symbol table shows only what the program itself keeps alive
+    mc_options opts = { MC_DROP_DEAD_GLOBALS, NULL, opt_level, disabled };
 
-        printf("\nOutput\n");
-        interpret(root);
+    if (path_count > 1 || fuel >= 0 || mem_limit) {
+        if (!path_count) {
+            fprintf(stderr, "--fuel and --mem-limit require source files\n");
+            goto out;
+        }
+        status = run_isolated(paths, path_count, &opts, pass_stats, workers, quantum, fuel, mem_limit);
+        goto out;
+    }
 
-        print_symbol_table();
+    // With the cache only the program output and the symbol table are
+    // printed; a cache hit never builds the unoptimised tree to dump.
+    opts.flags |= MC_DUMP_AST | MC_DUMP_IR;
+    if (cache_dir) {
+        if (!path) {
+            fprintf(stderr, "--cache requires a source file\n");
+            goto out;
+        }
+        opts.flags = MC_DROP_DEAD_GLOBALS;
+        opts.cache_dir = cache_dir;
+    }
 
-        free_ast(root);
+    char err[512];
+    if (path) {
+        prog = mc_compile_file(path, &opts, err, sizeof(err));
     } else {
-        fprintf(stderr, "Parsing failed.\n");
+        size_t len;
+        char *src = read_stream(stdin, &len);
+        prog = mc_compile(src, len, &opts, err, sizeof(err));
+        free(src);
+    }
+    if (!prog) {
+        fprintf(stderr, "%s\n", err);
+        goto out;
     }
 
-    if (yyin && yyin != stdin) {
-        fclose(yyin);
+    printf(cache_dir ? "Output\n" : "\nOutput\n");
+    status = run_program(prog, profile, folded_path);
+    if (pass_stats) {
+        fflush(stdout);
+        mc_pass_report(prog, stderr);
     }
-    return 0;
-}
\ No newline at end of file
+
+out:
+    mc_program_free(prog);
+    free(paths);
+    free(disabled);
+    return status;
+}
@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include "minicompiler.h"
+#include "ast.h"
+#include "interp.h"
+#include "sched.h"
+#include "lexer.h"
+#include "cache.h"
+#include "profile.h"
+#include "vectorize.h"
+#include "parallel.h"
+#include "passes.h"
+
+extern int yyparse();
+extern ASTNode *root;
+extern char parse_error[];
+
+struct mc_program {
+    ASTNode *root;
+    PassPlan *passes;
+    int cached;     // the tree lives in img rather than on the heap
+    CacheImage img;
+};
+
+typedef struct {
+    char *name;
+    int value;
+} Input;
+
+struct mc_context {
+    Interp *interp;
+    Input *inputs;
+    int input_count;
+    int input_capacity;
+};
+
+struct mc_scheduler {
+    Scheduler *sched;
+};
+
+// The lexer, parser and optimiser all keep global state
+static pthread_mutex_t compile_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// --- Compilation ---
+// Parse the lexer's current input; called with compile_lock held. Errors
+// are prefixed with the file name, if there is one.
+static ASTNode *parse_input(const char *path, char *err, size_t err_size) {
+    root = NULL;
+    parse_error[0] = '\0';
+    int failed = yyparse() != 0 || !root;
+    lex_close();
+    if (failed) {
+        snprintf(err, err_size, "%s%s%s", path ? path : "", path ? ": " : "",
+                 parse_error[0] ? parse_error : "Parsing failed.");
+        return NULL;
+    }
+    ASTNode *tree = root;
+    root = NULL;
+    return tree;
+}
+
+// Translate the optimisation settings of opts; fails on an unknown pass name
+static int pass_options(const mc_options *opts, PassOptions *out, char *err, size_t err_size) {
+    int level = opts && opts->opt_level != MC_OPT_DEFAULT ? opts->opt_level - MC_OPT_O0 : PASS_DEFAULT_LEVEL;
+    if (level < 0 || level > 3) {
+        snprintf(err, err_size, "Unknown optimisation level: %d", opts->opt_level);
+        return 0;
+    }
+    pass_options_init(out, level);
+    out->keep_globals = !(opts && (opts->flags & MC_DROP_DEAD_GLOBALS));
+    const char *names = opts ? opts->disable_passes : NULL;
+    while (names && *names) {
+        size_t len = strcspn(names, ",");
+        int id = pass_lookup(names, len);
+        if (id < 0) {
+            snprintf(err, err_size, "Unknown pass: %.*s", (int)len, names);
+            return 0;
+        }
+        out->enabled &= ~(1u << id);
+        names += len + (names[len] == ',');
+    }
+    return 1;
+}
+
+static PassPlan *optimise_program(ASTNode *tree, unsigned flags, const PassOptions *popts) {
+    if (flags & MC_DUMP_AST) {
+        printf("--- Abstract Syntax Tree (AST) ---\n");
+        print_ast(tree, 0);
+    }
+    PassPlan *plan = passes_run(tree, popts);
+    if (flags & MC_DUMP_IR) {
+        printf("\n--- Intermediate Code ---\n");
+        generate_intermediate_code(tree);
+    }
+    return plan;
+}
+
+static mc_program *new_program(ASTNode *tree, PassPlan *passes) {
+    mc_program *prog = calloc(1, sizeof(mc_program));
+    prog->root = tree;
+    prog->passes = passes;
+    return prog;
+}
+
+mc_program *mc_compile(const char *src, size_t len, const mc_options *opts, char *err, size_t err_size) {
+    unsigned flags = opts ? opts->flags : 0;
+    PassOptions popts;
+    if (!pass_options(opts, &popts, err, err_size)) return NULL;
+    pthread_mutex_lock(&compile_lock);
+    lex_set_buffer(src, len);
+    ASTNode *tree = parse_input(NULL, err, err_size);
+    mc_program *prog = tree ? new_program(tree, optimise_program(tree, flags, &popts)) : NULL;
+    pthread_mutex_unlock(&compile_lock);
+    return prog;
+}
+
+// With a cache directory, a hit skips parsing and optimisation altogether,
+// so no AST or IR dump is printed for it.
+mc_program *mc_compile_file(const char *path, const mc_options *opts, char *err, size_t err_size) {
+    unsigned flags = opts ? opts->flags : 0;
+    const char *cache_dir = opts ? opts->cache_dir : NULL;
+    mc_program *prog = NULL;
+    PassOptions popts;
+    if (!pass_options(opts, &popts, err, err_size)) return NULL;
+    pthread_mutex_lock(&compile_lock);
+    if (!lex_open_file(path)) {
+        snprintf(err, err_size, "%s: %s", path, strerror(errno));
+        pthread_mutex_unlock(&compile_lock);
+        return NULL;
+    }
+    uint64_t hash = 0;
+    if (cache_dir) {
+        size_t len;
+        const char *src = lex_input(&len);
+        hash = cache_hash_source(src, len) ^ pass_options_key(&popts);
+        CacheImage img;
+        if (cache_load(cache_dir, path, hash, &img)) {
+            lex_close();
+            prog = new_program(img.root, passes_run_cached(img.root, &popts));
+            prog->cached = 1;
+            prog->img = img;
+            pthread_mutex_unlock(&compile_lock);
+            return prog;
+        }
+    }
+    ASTNode *tree = parse_input(path, err, err_size);
+    if (tree) {
+        prog = new_program(tree, optimise_program(tree, flags, &popts));
+        if (cache_dir) {
+            // Cached trees are stored fully optimised
+            compile_all_functions(tree);
+            cache_store(cache_dir, path, hash, tree);
+        }
+    }
+    pthread_mutex_unlock(&compile_lock);
+    return prog;
+}
+
+void mc_program_free(mc_program *prog) {
+    if (!prog) return;
+    if (prog->cached) cache_release(&prog->img);
+    else free_ast(prog->root);
+    pass_plan_release(prog->passes);
+    free(prog);
+}
+
+void mc_pass_report(const mc_program *prog, FILE *out) {
+    passes_report(out, prog->passes);
+}
+
+// --- Contexts ---
+mc_context *mc_context_new(const mc_program *prog) {
+    mc_context *ctx = calloc(1, sizeof(mc_context));
+    ctx->interp = interp_new(prog->root);
+    return ctx;
+}
+
+void mc_context_free(mc_context *ctx) {
+    if (!ctx) return;
+    for (int i = 0; i < ctx->input_count; i++)
+        free(ctx->inputs[i].name);
+    free(ctx->inputs);
+    interp_free(ctx->interp);
+    free(ctx);
+}
+
+void mc_set_output(mc_context *ctx, mc_output_fn fn, void *user) {
+    interp_set_output(ctx->interp, fn, user);
+}
+
+const char *mc_output(const mc_context *ctx, size_t *len) {
+    return interp_output(ctx->interp, len);
+}
+
+void mc_set_var(mc_context *ctx, const char *name, int value) {
+    for (int i = 0; i < ctx->input_count; i++) {
+        if (strcmp(ctx->inputs[i].name, name) == 0) {
+            ctx->inputs[i].value = value;
+            return;
+        }
+    }
+    if (ctx->input_count == ctx->input_capacity) {
+        ctx->input_capacity = ctx->input_capacity ? ctx->input_capacity * 2 : 8;
+        ctx->inputs = realloc(ctx->inputs, sizeof(Input) * ctx->input_capacity);
+    }
+    ctx->inputs[ctx->input_count].name = strdup(name);
+    ctx->inputs[ctx->input_count].value = value;
+    ctx->input_count++;
+}
+
+int mc_get_var(const mc_context *ctx, const char *name, int *value) {
+    return interp_get_var(ctx->interp, name, value);
+}
+
+void mc_set_fuel(mc_context *ctx, long steps) {
+    interp_set_fuel(ctx->interp, steps);
+}
+
+void mc_set_memory_limit(mc_context *ctx, size_t bytes) {
+    interp_set_memory_limit(ctx->interp, bytes);
+}
+
+void mc_enable_fast_loops(mc_context *ctx, int enabled) {
+    interp_set_loop_plans(ctx->interp, enabled);
+}
+
+void mc_enable_profile(mc_context *ctx, int enabled) {
+    interp_set_profiled(ctx->interp, enabled);
+}
+
+static mc_status to_mc_status(InterpStatus status) {
+    switch (status) {
+        case INTERP_DONE: return MC_OK;
+        case INTERP_ERROR: return MC_ERROR;
+        case INTERP_KILLED: return MC_KILLED;
+        default: return MC_YIELD;
+    }
+}
+
+// Begin a new run unless one is in progress
+static void prepare_run(mc_context *ctx) {
+    Interp *in = ctx->interp;
+    if (interp_status(in) != INTERP_READY) interp_reset(in);
+    if (!interp_started(in)) {
+        for (int i = 0; i < ctx->input_count; i++)
+            interp_set_var(in, ctx->inputs[i].name, ctx->inputs[i].value);
+    }
+}
+
+mc_status mc_run_steps(mc_context *ctx, long steps) {
+    prepare_run(ctx);
+    return to_mc_status(interp_run(ctx->interp, steps));
+}
+
+mc_status mc_run(mc_context *ctx) {
+    return mc_run_steps(ctx, -1);
+}
+
+mc_status mc_context_status(const mc_context *ctx) {
+    return to_mc_status(interp_status(ctx->interp));
+}
+
+void mc_dump_symbols(mc_context *ctx) {
+    interp_dump_symbols(ctx->interp);
+}
+
+// --- Scheduling ---
+mc_scheduler *mc_scheduler_new(int workers, long quantum) {
+    mc_scheduler *s = malloc(sizeof(mc_scheduler));
+    s->sched = sched_new(workers, quantum);
+    return s;
+}
+
+void mc_scheduler_submit(mc_scheduler *s, mc_context *ctx) {
+    prepare_run(ctx);
+    sched_submit(s->sched, ctx->interp);
+}
+
+void mc_scheduler_wait(mc_scheduler *s) {
+    sched_wait(s->sched);
+}
+
+void mc_scheduler_free(mc_scheduler *s) {
+    if (!s) return;
+    sched_free(s->sched);
+    free(s);
+}
+
+// --- Process-wide settings ---
+void mc_set_vectorize(int enabled) {
+    vectorize_enabled = enabled;
+}
+
+void mc_set_threads(int threads, long min_trip) {
+    par_threads = threads;
+    par_min_trip = min_trip;
+}
+
+void mc_profile_report(FILE *out, const char *folded_path) {
+    profile_report(out, folded_path);
+}
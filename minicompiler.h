@@ -0,0 +1,112 @@
+#ifndef MINICOMPILER_H
+#define MINICOMPILER_H
+
+// libminicompiler: compile a script once, then run it any number of times in
+// lightweight contexts with host-supplied inputs.
+//
+//   mc_program *prog = mc_compile(src, len, NULL, err, sizeof(err));
+//   mc_context *ctx = mc_context_new(prog);
+//   mc_set_output(ctx, on_output, user);
+//   mc_set_var(ctx, "n", 42);
+//   if (mc_run(ctx) == MC_OK) mc_get_var(ctx, "result", &value);
+//
+// Compilation is serialised internally (the parser is not reentrant); a
+// compiled program is read-only, and any number of contexts may run it
+// concurrently, one thread per context at a time. Parallel loops share one
+// process-wide thread pool, so contexts that reach one together take turns.
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MC_API __attribute__((visibility("default")))
+
+typedef struct mc_program mc_program;
+typedef struct mc_context mc_context;
+typedef struct mc_scheduler mc_scheduler;
+
+typedef enum {
+    MC_OK,
+    MC_YIELD,  // step budget of mc_run_steps() used up; call again to continue
+    MC_ERROR,  // runtime error, message already delivered as output
+    MC_KILLED  // fuel or memory limit exceeded
+} mc_status;
+
+// Program output, in order; not NUL-terminated. Text is buffered and handed
+// over in chunks of about 64 KiB, and in full before mc_run(), mc_run_steps()
+// or mc_dump_symbols() returns.
+typedef void (*mc_output_fn)(void *user, const char *text, size_t len);
+
+enum {
+    MC_DUMP_AST = 1 << 0, // print the parsed tree to stdout before optimising
+    MC_DUMP_IR  = 1 << 1, // print the optimised intermediate code to stdout
+    // Let dead-assignment removal drop globals the program itself never
+    // reads. Without it every assigned global survives for mc_get_var().
+    MC_DROP_DEAD_GLOBALS = 1 << 2
+};
+
+enum {
+    MC_OPT_DEFAULT, // -O2
+    MC_OPT_O0,      // no optimisation
+    MC_OPT_O1,      // constant folding and dead assignment removal
+    MC_OPT_O2,      // also dead functions and vectorised/parallel loop plans
+    MC_OPT_O3       // as -O2, repeated until nothing changes
+};
+
+typedef struct {
+    unsigned flags;
+    const char *cache_dir;      // mc_compile_file() only: reuse compiled programs from here
+    int opt_level;              // MC_OPT_*
+    const char *disable_passes; // comma-separated: dead-functions, fold, dce, vectorize, parallelize
+} mc_options;
+
+// On failure these return NULL and describe the problem in err.
+MC_API mc_program *mc_compile(const char *src, size_t len, const mc_options *opts, char *err, size_t err_size);
+MC_API mc_program *mc_compile_file(const char *path, const mc_options *opts, char *err, size_t err_size);
+MC_API void mc_program_free(mc_program *prog);
+// Runs, nodes visited and removed, and time for each optimisation pass,
+// including function bodies compiled so far.
+MC_API void mc_pass_report(const mc_program *prog, FILE *out);
+
+MC_API mc_context *mc_context_new(const mc_program *prog);
+MC_API void mc_context_free(mc_context *ctx);
+
+// Without a callback, output is collected and read with mc_output().
+MC_API void mc_set_output(mc_context *ctx, mc_output_fn fn, void *user);
+MC_API const char *mc_output(const mc_context *ctx, size_t *len);
+
+// Inputs become global variables at the start of every run.
+MC_API void mc_set_var(mc_context *ctx, const char *name, int value);
+MC_API int mc_get_var(const mc_context *ctx, const char *name, int *value);
+
+MC_API void mc_set_fuel(mc_context *ctx, long steps);          // per run; < 0 is unlimited
+MC_API void mc_set_memory_limit(mc_context *ctx, size_t bytes); // 0 is unlimited
+MC_API void mc_enable_fast_loops(mc_context *ctx, int enabled); // vectorised/parallel loops; not fuel-metered
+MC_API void mc_enable_profile(mc_context *ctx, int enabled);    // single-threaded use only
+
+// A finished context starts over with fresh variables; a yielded one resumes.
+MC_API mc_status mc_run(mc_context *ctx);
+MC_API mc_status mc_run_steps(mc_context *ctx, long steps);
+MC_API mc_status mc_context_status(const mc_context *ctx);
+MC_API void mc_dump_symbols(mc_context *ctx); // global variables, as output
+
+// Interleave many contexts on a pool of threads, `quantum` steps at a time.
+MC_API mc_scheduler *mc_scheduler_new(int workers, long quantum);
+MC_API void mc_scheduler_submit(mc_scheduler *s, mc_context *ctx);
+MC_API void mc_scheduler_wait(mc_scheduler *s);
+MC_API void mc_scheduler_free(mc_scheduler *s);
+
+// Process-wide settings, shared by every context: call them before running
+// anything, not while other threads are inside mc_run().
+MC_API void mc_set_vectorize(int enabled);              // SIMD kernels for fast loops
+MC_API void mc_set_threads(int threads, long min_trip); // parallel loop pool size and threshold
+MC_API void mc_profile_report(FILE *out, const char *folded_path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,39 @@
+#include <stdio.h>
+#include <string.h>
+#include "output.h"
+
+OutStream out_stdout;
+
+// Digits are produced backwards into a scratch buffer, then copied. Works in
+// unsigned arithmetic so INT_MIN needs no special case.
+int format_int(char *dst, int value) {
+    char digits[OUTPUT_INT_MAX];
+    char *p = digits + sizeof(digits);
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        *--p = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    if (value < 0) *--p = '-';
+    int len = digits + sizeof(digits) - p;
+    memcpy(dst, p, len);
+    return len;
+}
+
+void stream_write(OutStream *s, const char *text, size_t len) {
+    if (s->len + len > OUTPUT_BUFFER_SIZE) {
+        stream_flush(s);
+        // Too big to be worth copying
+        if (len > OUTPUT_BUFFER_SIZE) {
+            fwrite(text, 1, len, s->file ? s->file : stdout);
+            return;
+        }
+    }
+    memcpy(s->buf + s->len, text, len);
+    s->len += len;
+}
+
+void stream_flush(OutStream *s) {
+    if (s->len) fwrite(s->buf, 1, s->len, s->file ? s->file : stdout);
+    s->len = 0;
+}
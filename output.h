@@ -0,0 +1,42 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <string.h>
+
+// Buffered text output. A stream gathers text in a large buffer and hands it
+// to its FILE only when the buffer is full or at an explicit stream_flush(),
+// so a dump costs one stdio call per OUTPUT_BUFFER_SIZE bytes rather than one
+// per line. Anything else writing to the same FILE must flush the stream
+// first to keep the output in order.
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+#define OUTPUT_INT_MAX 11 // "-2147483648"
+
+typedef struct {
+    FILE *file;
+    size_t len;
+    char buf[OUTPUT_BUFFER_SIZE];
+} OutStream;
+
+// The AST and IR dumps; they run under the compile lock
+extern OutStream out_stdout;
+
+int format_int(char *dst, int value); // no terminator; returns the length
+void stream_write(OutStream *s, const char *text, size_t len);
+void stream_flush(OutStream *s);
+
+static inline void stream_char(OutStream *s, char c) {
+    if (s->len == OUTPUT_BUFFER_SIZE) stream_flush(s);
+    s->buf[s->len++] = c;
+}
+
+static inline void stream_str(OutStream *s, const char *text) {
+    stream_write(s, text, strlen(text));
+}
+
+static inline void stream_int(OutStream *s, int value) {
+    if (s->len + OUTPUT_INT_MAX > OUTPUT_BUFFER_SIZE) stream_flush(s);
+    s->len += format_int(s->buf + s->len, value);
+}
+
+#endif
@@ -0,0 +1,501 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include "parallel.h"
+#include "passes.h"
+
+int par_threads = 1;
+long par_min_trip = 10000;
+
+#define PAR_MAX_STACK 64
+#define PAR_MAX_NESTING 256 // analysis recurses; deeper expressions get no plan
+#define PAR_CHUNKS_PER_THREAD 4
+
+// --- Loop bodies compiled to a small stack program ---
+// Worker threads cannot touch the symbol table, so the per-iteration
+// expression is flattened to postfix ops over pre-resolved slots.
+typedef enum {
+    OP_CONST, OP_SCALAR, OP_INDUCTION, OP_LOAD,
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE
+} ParOpcode;
+
+typedef struct {
+    ParOpcode op;
+    int arg; // constant value or slot number
+} ParOp;
+
+typedef struct {
+    const char *name;
+    int is_array;
+} ParSlot;
+
+struct ParLoop {
+    ParKind kind;
+    const char *var;    // induction variable
+    int inclusive;      // condition is var <= limit
+    int step;           // constant increment, > 0
+    ASTNode *limit;     // loop-invariant bound
+    const char *target; // accumulator, or destination array for PAR_MAP
+    ParOp *code;
+    int code_len;
+    int max_stack;
+    ParSlot *slots;
+    int slot_count;
+};
+
+static int is_id(ASTNode *e, const char *name) {
+    return e && e->type == NODE_ID && strcmp(e->data.id_name, name) == 0;
+}
+
+static ASTNode *single_statement(ASTNode *body) {
+    if (body && body->type == NODE_BLOCK)
+        return body->data.block.count == 1 ? body->data.block.statements[0] : NULL;
+    return body;
+}
+
+static int same_expr(ASTNode *a, ASTNode *b, int nesting) {
+    if (nesting > PAR_MAX_NESTING || a->type != b->type) return 0;
+    switch (a->type) {
+        case NODE_NUM: return a->data.num_val == b->data.num_val;
+        case NODE_ID: return strcmp(a->data.id_name, b->data.id_name) == 0;
+        case NODE_INDEX:
+            return strcmp(a->data.index.name, b->data.index.name) == 0 && same_expr(a->data.index.index, b->data.index.index, nesting + 1);
+        case NODE_BINOP:
+            return strcmp(a->data.binop.op, b->data.binop.op) == 0
+                && same_expr(a->data.binop.left, b->data.binop.left, nesting + 1)
+                && same_expr(a->data.binop.right, b->data.binop.right, nesting + 1);
+        default: return 0;
+    }
+}
+
+static void emit(ParLoop *p, ParOpcode op, int arg) {
+    p->code = realloc(p->code, sizeof(ParOp) * (p->code_len + 1));
+    p->code[p->code_len].op = op;
+    p->code[p->code_len].arg = arg;
+    p->code_len++;
+}
+
+static int slot_for(ParLoop *p, const char *name, int is_array) {
+    for (int i = 0; i < p->slot_count; i++) {
+        if (strcmp(p->slots[i].name, name) == 0)
+            return p->slots[i].is_array == is_array ? i : -1;
+    }
+    p->slots = realloc(p->slots, sizeof(ParSlot) * (p->slot_count + 1));
+    p->slots[p->slot_count].name = name;
+    p->slots[p->slot_count].is_array = is_array;
+    return p->slot_count++;
+}
+
+static const struct { const char *text; ParOpcode op; } binops[] = {
+    { "+", OP_ADD }, { "-", OP_SUB }, { "*", OP_MUL }, { "/", OP_DIV },
+    { "==", OP_EQ }, { "!=", OP_NE }, { "<", OP_LT }, { "<=", OP_LE }, { ">", OP_GT }, { ">=", OP_GE },
+};
+
+// Compile e, leaving its value on the stack. depth is the stack height
+// before e runs; nesting is e's depth in the tree. Fails on anything that
+// reads the accumulator or has effects.
+static int compile_expr(ParLoop *p, ASTNode *e, int depth, int nesting) {
+    if (depth + 1 > PAR_MAX_STACK || nesting > PAR_MAX_NESTING) return 0;
+    if (depth + 1 > p->max_stack) p->max_stack = depth + 1;
+    switch (e->type) {
+        case NODE_NUM:
+            emit(p, OP_CONST, e->data.num_val);
+            return 1;
+        case NODE_ID: {
+            if (strcmp(e->data.id_name, p->var) == 0) {
+                emit(p, OP_INDUCTION, 0);
+                return 1;
+            }
+            if (strcmp(e->data.id_name, p->target) == 0) return 0;
+            int slot = slot_for(p, e->data.id_name, 0);
+            if (slot < 0) return 0;
+            emit(p, OP_SCALAR, slot);
+            return 1;
+        }
+        case NODE_INDEX: {
+            // A map may read its own destination, but only the element it writes.
+            if (strcmp(e->data.index.name, p->target) == 0
+                && !(p->kind == PAR_MAP && is_id(e->data.index.index, p->var)))
+                return 0;
+            int slot = slot_for(p, e->data.index.name, 1);
+            if (slot < 0 || !compile_expr(p, e->data.index.index, depth, nesting + 1)) return 0;
+            emit(p, OP_LOAD, slot);
+            return 1;
+        }
+        case NODE_BINOP:
+            for (size_t i = 0; i < sizeof(binops) / sizeof(binops[0]); i++) {
+                if (strcmp(e->data.binop.op, binops[i].text) != 0) continue;
+                if (!compile_expr(p, e->data.binop.left, depth, nesting + 1)
+                    || !compile_expr(p, e->data.binop.right, depth + 1, nesting + 1))
+                    return 0;
+                emit(p, binops[i].op, 0);
+                return 1;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static int invariant_ok(ASTNode *e, const char *var, const char *target, int nesting) {
+    if (nesting > PAR_MAX_NESTING) return 0;
+    switch (e->type) {
+        case NODE_NUM: return 1;
+        case NODE_ID: return strcmp(e->data.id_name, var) != 0 && strcmp(e->data.id_name, target) != 0;
+        case NODE_BINOP:
+            return invariant_ok(e->data.binop.left, var, target, nesting + 1)
+                && invariant_ok(e->data.binop.right, var, target, nesting + 1);
+        default: return 0;
+    }
+}
+
+// Pick the reduction (or map) performed by the loop body; returns the
+// per-iteration expression.
+static ASTNode *match_body(ParLoop *p, ASTNode *stmt) {
+    if (stmt->type == NODE_INDEX_ASSIGN) {
+        if (!is_id(stmt->data.index_assign.index, p->var)) return NULL;
+        p->kind = PAR_MAP;
+        p->target = stmt->data.index_assign.name;
+        return stmt->data.index_assign.expr;
+    }
+    if (stmt->type == NODE_ASSIGN) {
+        ASTNode *rhs = stmt->data.assign.expr;
+        p->target = stmt->data.assign.id;
+        if (rhs->type != NODE_BINOP) return NULL;
+        if (strcmp(rhs->data.binop.op, "+") == 0) p->kind = PAR_SUM;
+        else if (strcmp(rhs->data.binop.op, "*") == 0) p->kind = PAR_PRODUCT;
+        else return NULL;
+        if (is_id(rhs->data.binop.left, p->target)) return rhs->data.binop.right;
+        if (is_id(rhs->data.binop.right, p->target)) return rhs->data.binop.left;
+        return NULL;
+    }
+    if (stmt->type == NODE_IF && !stmt->data.if_stmt.else_branch) {
+        // if (E < m) m = E;  and the mirrored / max forms
+        ASTNode *cond = stmt->data.if_stmt.cond;
+        ASTNode *assign = single_statement(stmt->data.if_stmt.then_branch);
+        if (!cond || cond->type != NODE_BINOP || !assign || assign->type != NODE_ASSIGN) return NULL;
+        const char *op = cond->data.binop.op;
+        if (op[0] != '<' && op[0] != '>') return NULL;
+        p->target = assign->data.assign.id;
+        ASTNode *elem;
+        int less;
+        if (is_id(cond->data.binop.right, p->target)) {
+            elem = cond->data.binop.left;
+            less = op[0] == '<';
+        } else if (is_id(cond->data.binop.left, p->target)) {
+            elem = cond->data.binop.right;
+            less = op[0] == '>';
+        } else {
+            return NULL;
+        }
+        if (!same_expr(elem, assign->data.assign.expr, 0)) return NULL;
+        p->kind = less ? PAR_MIN : PAR_MAX;
+        return elem;
+    }
+    return NULL;
+}
+
+static ParLoop *analyse_for(ASTNode *node) {
+    ASTNode *cond = node->data.for_stmt.cond;
+    ASTNode *inc = node->data.for_stmt.inc;
+    ASTNode *stmt = single_statement(node->data.for_stmt.body);
+    if (!cond || !inc || !stmt || cond->type != NODE_BINOP || cond->data.binop.left->type != NODE_ID)
+        return NULL;
+
+    ParLoop p = {0};
+    p.var = cond->data.binop.left->data.id_name;
+    if (strcmp(cond->data.binop.op, "<") == 0) p.inclusive = 0;
+    else if (strcmp(cond->data.binop.op, "<=") == 0) p.inclusive = 1;
+    else return NULL;
+    p.limit = cond->data.binop.right;
+
+    // var = var + c or var = c + var, with a positive constant c
+    ASTNode *step = inc->type == NODE_ASSIGN ? inc->data.assign.expr : NULL;
+    if (!step || strcmp(inc->data.assign.id, p.var) != 0 || step->type != NODE_BINOP
+        || strcmp(step->data.binop.op, "+") != 0)
+        return NULL;
+    ASTNode *amount = is_id(step->data.binop.left, p.var) ? step->data.binop.right
+                    : is_id(step->data.binop.right, p.var) ? step->data.binop.left : NULL;
+    if (!amount || amount->type != NODE_NUM || amount->data.num_val <= 0) return NULL;
+    p.step = amount->data.num_val;
+
+    ASTNode *elem = match_body(&p, stmt);
+    if (!elem || strcmp(p.target, p.var) == 0 || !invariant_ok(p.limit, p.var, p.target, 0)
+        || !compile_expr(&p, elem, 0, 0)) {
+        free(p.code);
+        free(p.slots);
+        return NULL;
+    }
+    ParLoop *loop = malloc(sizeof(ParLoop));
+    *loop = p;
+    return loop;
+}
+
+// Attach a plan to every for loop that is a parallel reduction or map.
+void parallelize_loops(ASTNode *node, PassStats *stats) {
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        node = s.items[--s.count].node;
+        stats->visited++;
+        switch (node->type) {
+            case NODE_BLOCK:
+                for (int i = node->data.block.count - 1; i >= 0; i--)
+                    walk_push(&s, &node->data.block.statements[i], 0);
+                break;
+            case NODE_IF:
+                walk_push(&s, &node->data.if_stmt.else_branch, 0);
+                walk_push(&s, &node->data.if_stmt.then_branch, 0);
+                break;
+            case NODE_WHILE:
+                walk_push(&s, &node->data.while_stmt.body, 0);
+                break;
+            case NODE_FOR:
+                par_free(node->data.for_stmt.par);
+                node->data.for_stmt.par = analyse_for(node);
+                if (!node->data.for_stmt.par) walk_push(&s, &node->data.for_stmt.body, 0);
+                break;
+            default:
+                break;
+        }
+    }
+    walk_done(&s);
+}
+
+void par_free(ParLoop *loop) {
+    if (!loop) return;
+    free(loop->code);
+    free(loop->slots);
+    free(loop);
+}
+
+// --- Execution ---
+typedef struct {
+    ParLoop *loop;
+    int start;
+    long long trips;
+    long long chunk_size;
+    int chunks;
+    int *scalars;     // slot values
+    int **arrays;     // slot storage
+    int *lengths;
+    int *out;         // PAR_MAP results, committed only if every chunk succeeds
+    int *partials;    // one per chunk
+    int *failed;      // one per chunk
+} ParJob;
+
+// Evaluate the loop expression for one induction value. Returns 0 where the
+// sequential interpreter would stop with an error (bad index, division by
+// zero); the caller then falls back to the ordinary loop to report it.
+static int eval_code(const ParJob *job, int iv, int *stack, int *result) {
+    const ParLoop *p = job->loop;
+    int sp = 0;
+    for (int pc = 0; pc < p->code_len; pc++) {
+        const ParOp *op = &p->code[pc];
+        int r;
+        switch (op->op) {
+            case OP_CONST: stack[sp++] = op->arg; continue;
+            case OP_SCALAR: stack[sp++] = job->scalars[op->arg]; continue;
+            case OP_INDUCTION: stack[sp++] = iv; continue;
+            case OP_LOAD: {
+                int index = stack[sp - 1];
+                if (index < 0 || index >= job->lengths[op->arg]) return 0;
+                stack[sp - 1] = job->arrays[op->arg][index];
+                continue;
+            }
+            default:
+                break;
+        }
+        int l = stack[sp - 2];
+        r = stack[sp - 1];
+        switch (op->op) {
+            case OP_ADD: l = (int)((unsigned)l + (unsigned)r); break;
+            case OP_SUB: l = (int)((unsigned)l - (unsigned)r); break;
+            case OP_MUL: l = (int)((unsigned)l * (unsigned)r); break;
+            case OP_DIV:
+                if (r == 0 || (l == INT_MIN && r == -1)) return 0;
+                l = l / r;
+                break;
+            case OP_EQ: l = l == r; break;
+            case OP_NE: l = l != r; break;
+            case OP_LT: l = l < r; break;
+            case OP_LE: l = l <= r; break;
+            case OP_GT: l = l > r; break;
+            case OP_GE: l = l >= r; break;
+            default: break;
+        }
+        stack[sp - 2] = l;
+        sp--;
+    }
+    *result = stack[0];
+    return 1;
+}
+
+static int identity(ParKind kind) {
+    switch (kind) {
+        case PAR_PRODUCT: return 1;
+        case PAR_MIN: return INT_MAX;
+        case PAR_MAX: return INT_MIN;
+        default: return 0;
+    }
+}
+
+static int combine(ParKind kind, int acc, int value) {
+    switch (kind) {
+        case PAR_SUM: return (int)((unsigned)acc + (unsigned)value);
+        case PAR_PRODUCT: return (int)((unsigned)acc * (unsigned)value);
+        case PAR_MIN: return value < acc ? value : acc;
+        case PAR_MAX: return value > acc ? value : acc;
+        default: return value;
+    }
+}
+
+static void run_chunk(ParJob *job, int chunk) {
+    const ParLoop *p = job->loop;
+    long long first = chunk * job->chunk_size;
+    long long last = first + job->chunk_size < job->trips ? first + job->chunk_size : job->trips;
+    int stack[PAR_MAX_STACK];
+    int acc = identity(p->kind);
+    for (long long k = first; k < last; k++) {
+        int value;
+        if (!eval_code(job, (int)(job->start + k * p->step), stack, &value)) {
+            job->failed[chunk] = 1;
+            return;
+        }
+        if (p->kind == PAR_MAP) job->out[k] = value;
+        else acc = combine(p->kind, acc, value);
+    }
+    job->partials[chunk] = acc;
+}
+
+// --- Thread pool ---
+// The pool runs one job at a time; job_lock queues callers from other
+// contexts until the current job has finished.
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+static int pool_size = 0;
+static ParJob *current_job = NULL;
+static int job_next = 0;
+static int job_remaining = 0;
+static unsigned job_generation = 0;
+
+// Called with pool_lock held; claims chunks until none are left.
+static void work_on_current_job(void) {
+    while (current_job && job_next < current_job->chunks) {
+        ParJob *job = current_job;
+        int chunk = job_next++;
+        pthread_mutex_unlock(&pool_lock);
+        run_chunk(job, chunk);
+        pthread_mutex_lock(&pool_lock);
+        if (--job_remaining == 0) pthread_cond_signal(&pool_done);
+    }
+}
+
+static void *worker_main(void *unused) {
+    (void)unused;
+    unsigned seen = 0;
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (job_generation == seen) pthread_cond_wait(&pool_wake, &pool_lock);
+        seen = job_generation;
+        work_on_current_job();
+    }
+    return NULL;
+}
+
+static void grow_pool(int workers) {
+    while (pool_size < workers) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, worker_main, NULL) != 0) break;
+        pthread_detach(thread);
+        pool_size++;
+    }
+}
+
+// The calling thread works on the job too, then waits for the stragglers.
+// The pool grows under job_lock, so only one caller ever starts workers.
+static void run_job(ParJob *job) {
+    pthread_mutex_lock(&job_lock);
+    grow_pool(par_threads - 1);
+    pthread_mutex_lock(&pool_lock);
+    current_job = job;
+    job_next = 0;
+    job_remaining = job->chunks;
+    job_generation++;
+    pthread_cond_broadcast(&pool_wake);
+    work_on_current_job();
+    while (job_remaining > 0) pthread_cond_wait(&pool_done, &pool_lock);
+    current_job = NULL;
+    pthread_mutex_unlock(&pool_lock);
+    pthread_mutex_unlock(&job_lock);
+}
+
+int par_run(ParLoop *loop) {
+    if (par_threads <= 1) return 0;
+    int start, acc = 0, target_length = 0;
+    int *target = NULL;
+    if (!lookup_var(loop->var, &start)) return 0;
+    int limit = eval_expr(loop->limit);
+    long long span = (long long)limit - start + loop->inclusive;
+    if (span <= 0) return 0;
+    long long trips = (span + loop->step - 1) / loop->step;
+    long long final = start + trips * loop->step;
+    if (trips < par_min_trip || final > INT_MAX) return 0;
+
+    if (loop->kind == PAR_MAP) {
+        target = lookup_array(loop->target, &target_length);
+        if (!target || start < 0 || final - loop->step >= target_length) return 0;
+    } else if (!lookup_var(loop->target, &acc)) {
+        return 0;
+    }
+
+    ParJob job = {0};
+    job.loop = loop;
+    job.start = start;
+    job.trips = trips;
+    job.scalars = calloc(loop->slot_count + 1, sizeof(int));
+    job.arrays = calloc(loop->slot_count + 1, sizeof(int *));
+    job.lengths = calloc(loop->slot_count + 1, sizeof(int));
+    int ready = 1;
+    for (int i = 0; i < loop->slot_count && ready; i++) {
+        if (loop->slots[i].is_array) ready = (job.arrays[i] = lookup_array(loop->slots[i].name, &job.lengths[i])) != NULL;
+        else ready = lookup_var(loop->slots[i].name, &job.scalars[i]);
+    }
+
+    int ok = 0;
+    if (ready) {
+        job.chunks = par_threads * PAR_CHUNKS_PER_THREAD;
+        if (job.chunks > trips) job.chunks = (int)trips;
+        job.chunk_size = (trips + job.chunks - 1) / job.chunks;
+        job.partials = calloc(job.chunks, sizeof(int));
+        job.failed = calloc(job.chunks, sizeof(int));
+        if (loop->kind == PAR_MAP) job.out = malloc(sizeof(int) * trips);
+        run_job(&job);
+
+        ok = 1;
+        for (int c = 0; c < job.chunks; c++)
+            if (job.failed[c]) ok = 0;
+        if (ok && loop->kind == PAR_MAP) {
+            for (long long k = 0; k < trips; k++)
+                target[start + k * loop->step] = job.out[k];
+        } else if (ok) {
+            for (int c = 0; c < job.chunks; c++)
+                acc = combine(loop->kind, acc, job.partials[c]);
+            set_var(loop->target, acc);
+        }
+        if (ok) set_var(loop->var, (int)final);
+    }
+
+    free(job.scalars);
+    free(job.arrays);
+    free(job.lengths);
+    free(job.partials);
+    free(job.failed);
+    free(job.out);
+    return ok;
+}
@@ -0,0 +1,22 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "ast.h"
+
+// For loops whose iterations are independent apart from one associative
+// reduction, e.g.
+//   for (j = 1; j <= N; j = j + 1) total = total + j * j;
+//   for (i = 0; i < n; i = i + 1) if (a[i] > best) best = a[i];
+//   for (i = 0; i < n; i = i + 1) c[i] = a[i] / (i + 1);
+// are split into chunks and run on a thread pool. The body must be that one
+// statement: prints, calls and any other writes keep the loop sequential.
+typedef enum { PAR_MAP, PAR_SUM, PAR_PRODUCT, PAR_MIN, PAR_MAX } ParKind;
+
+extern int par_threads;        // worker threads; 1 disables the transformation
+extern long par_min_trip;      // loops with fewer iterations stay sequential
+
+void parallelize_loops(ASTNode *node, PassStats *stats);
+int par_run(ParLoop *loop);
+void par_free(ParLoop *loop);
+
+#endif
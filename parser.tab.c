@@ -0,0 +1,1787 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 6 "parser.y"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+extern int yylex();
+void yyerror(const char *s);
+ASTNode *root = NULL;
+char parse_error[256]; // message from the last failed yyparse()
+extern int yylineno; // For error reporting
+
+// Nested input needs a deep parser stack; bison grows it on the heap.
+#define YYINITDEPTH 1024
+#define YYMAXDEPTH 50000000
+
+#line 87 "parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IF = 3,                         /* IF  */
+  YYSYMBOL_ELSE = 4,                       /* ELSE  */
+  YYSYMBOL_RETURN = 5,                     /* RETURN  */
+  YYSYMBOL_FOR = 6,                        /* FOR  */
+  YYSYMBOL_WHILE = 7,                      /* WHILE  */
+  YYSYMBOL_PRINT = 8,                      /* PRINT  */
+  YYSYMBOL_FUNC = 9,                       /* FUNC  */
+  YYSYMBOL_BREAK = 10,                     /* BREAK  */
+  YYSYMBOL_NUMBER = 11,                    /* NUMBER  */
+  YYSYMBOL_ID = 12,                        /* ID  */
+  YYSYMBOL_EQ = 13,                        /* EQ  */
+  YYSYMBOL_NE = 14,                        /* NE  */
+  YYSYMBOL_LT = 15,                        /* LT  */
+  YYSYMBOL_GT = 16,                        /* GT  */
+  YYSYMBOL_LE = 17,                        /* LE  */
+  YYSYMBOL_GE = 18,                        /* GE  */
+  YYSYMBOL_19_ = 19,                       /* '+'  */
+  YYSYMBOL_20_ = 20,                       /* '-'  */
+  YYSYMBOL_21_ = 21,                       /* '*'  */
+  YYSYMBOL_22_ = 22,                       /* '/'  */
+  YYSYMBOL_23_ = 23,                       /* '='  */
+  YYSYMBOL_24_ = 24,                       /* '('  */
+  YYSYMBOL_25_ = 25,                       /* ')'  */
+  YYSYMBOL_26_ = 26,                       /* ','  */
+  YYSYMBOL_27_ = 27,                       /* ';'  */
+  YYSYMBOL_28_ = 28,                       /* '['  */
+  YYSYMBOL_29_ = 29,                       /* ']'  */
+  YYSYMBOL_30_ = 30,                       /* '{'  */
+  YYSYMBOL_31_ = 31,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 32,                  /* $accept  */
+  YYSYMBOL_program = 33,                   /* program  */
+  YYSYMBOL_toplevel_list = 34,             /* toplevel_list  */
+  YYSYMBOL_toplevel = 35,                  /* toplevel  */
+  YYSYMBOL_funcdef = 36,                   /* funcdef  */
+  YYSYMBOL_37_1 = 37,                      /* @1  */
+  YYSYMBOL_param_list = 38,                /* param_list  */
+  YYSYMBOL_stmt_list = 39,                 /* stmt_list  */
+  YYSYMBOL_statement = 40,                 /* statement  */
+  YYSYMBOL_for_init = 41,                  /* for_init  */
+  YYSYMBOL_for_inc = 42,                   /* for_inc  */
+  YYSYMBOL_block = 43,                     /* block  */
+  YYSYMBOL_expr = 44,                      /* expr  */
+  YYSYMBOL_arg_list = 45                   /* arg_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  3
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   303
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  32
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  14
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  49
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  109
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   273
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+      24,    25,    21,    19,    26,    20,     2,    22,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    27,
+       2,    23,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    28,     2,    29,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    30,     2,    31,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
+{
+       0,    70,    70,    74,    75,    83,    84,    88,    88,    95,
+      96,    97,   105,   106,   114,   115,   116,   117,   118,   119,
+     120,   121,   122,   123,   128,   129,   130,   134,   135,   139,
+     140,   144,   148,   149,   150,   151,   152,   153,   154,   155,
+     156,   157,   158,   159,   160,   161,   162,   166,   167,   168
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "IF", "ELSE", "RETURN",
+  "FOR", "WHILE", "PRINT", "FUNC", "BREAK", "NUMBER", "ID", "EQ", "NE",
+  "LT", "GT", "LE", "GE", "'+'", "'-'", "'*'", "'/'", "'='", "'('", "')'",
+  "','", "';'", "'['", "']'", "'{'", "'}'", "$accept", "program",
+  "toplevel_list", "toplevel", "funcdef", "@1", "param_list", "stmt_list",
+  "statement", "for_init", "for_inc", "block", "expr", "arg_list", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-33)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     -33,    14,    83,   -33,    -1,    -8,     0,     4,    17,   -33,
+      16,   -33,   -11,    -6,   -33,   -33,   -33,   -33,   -33,   167,
+      -6,   -17,   -33,   182,    29,    -6,    18,    34,   -33,    19,
+      -6,    -6,    -6,   242,    47,    -6,    -6,    -6,    -6,    -6,
+      -6,    -6,    -6,    -6,    -6,   -33,   255,    -6,   -33,    25,
+      24,   268,   -33,    32,    -6,   197,   281,   -16,   116,   -33,
+     -33,   -33,   -33,   -33,   -33,   -33,   -33,   -33,   102,   102,
+      49,    49,    98,   133,    -6,    -6,    98,    48,   150,   -33,
+     -33,    -6,    45,    68,   -33,   281,   212,   -33,   -33,    -4,
+      46,   281,    -6,    98,    63,    50,    67,   -33,   227,   -33,
+      58,    57,   -33,   -33,   -33,    -6,    98,   281,   -33
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       3,     0,     2,     1,     0,     0,     0,     0,     0,     7,
+       0,    43,    44,     0,    12,     4,     5,     6,    25,     0,
+       0,    44,    17,     0,    28,     0,     0,     0,    22,     0,
+       0,    47,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    26,     0,     0,    16,     0,
+       0,     0,    15,     0,     0,     0,    48,     0,     0,    42,
+      31,    13,    36,    37,    38,    40,    39,    41,    32,    33,
+      34,    35,     0,     0,     0,     0,     0,     9,     0,    14,
+      45,     0,    46,    19,    46,    27,     0,    20,    10,     0,
+       0,    49,     0,     0,    30,     0,     0,    23,     0,    18,
+       0,     0,     8,    11,    24,     0,     0,    29,    21
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -33,   -33,   -33,   -33,   -33,   -33,   -33,   -33,   -32,   -33,
+     -33,   -12,    -5,   -33
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     1,     2,    15,    16,    27,    89,    34,    17,    50,
+     101,    18,    19,    57
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      23,    29,    61,    11,    21,    11,    21,    31,    33,    80,
+      81,    47,    30,    31,     3,    46,    13,    32,    13,    22,
+      51,    95,    96,    20,    24,    55,    56,    58,    25,    26,
+      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
+      83,    49,    73,    28,    87,    52,    53,    54,    74,    78,
+       4,    75,     5,     6,     7,     8,    77,    10,    11,    12,
+      88,    99,    35,    36,    37,    38,    39,    40,    92,    85,
+      86,    13,    93,    97,   108,   100,    91,    14,    60,   103,
+      14,   105,   106,   102,     0,     0,     4,    98,     5,     6,
+       7,     8,     9,    10,    11,    12,     0,     0,     0,     0,
+     107,     4,     0,     5,     6,     7,     8,    13,    10,    11,
+      12,     0,     0,    14,     0,    35,    36,    37,    38,    39,
+      40,     0,    13,    43,    44,     0,     0,     0,    14,    35,
+      36,    37,    38,    39,    40,    41,    42,    43,    44,     0,
+       0,     0,     0,     0,     0,    82,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,     0,     0,     0,     0,
+       0,     0,    84,    35,    36,    37,    38,    39,    40,    41,
+      42,    43,    44,     0,     0,     0,     0,     0,     0,    90,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+       0,     0,     0,     0,    45,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    44,     0,     0,     0,     0,    48,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+       0,     0,     0,     0,    79,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    44,     0,     0,     0,     0,    94,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+       0,     0,     0,     0,   104,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    44,     0,     0,    59,    35,    36,
+      37,    38,    39,    40,    41,    42,    43,    44,     0,     0,
+      72,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      44,     0,     0,    76,    35,    36,    37,    38,    39,    40,
+      41,    42,    43,    44
+};
+
+static const yytype_int8 yycheck[] =
+{
+       5,    12,    34,    11,    12,    11,    12,    24,    13,    25,
+      26,    28,    23,    24,     0,    20,    24,    28,    24,    27,
+      25,    25,    26,    24,    24,    30,    31,    32,    24,    12,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      72,    12,    47,    27,    76,    27,    12,    28,    23,    54,
+       3,    27,     5,     6,     7,     8,    24,    10,    11,    12,
+      12,    93,    13,    14,    15,    16,    17,    18,    23,    74,
+      75,    24,     4,    27,   106,    12,    81,    30,    31,    12,
+      30,    23,    25,    95,    -1,    -1,     3,    92,     5,     6,
+       7,     8,     9,    10,    11,    12,    -1,    -1,    -1,    -1,
+     105,     3,    -1,     5,     6,     7,     8,    24,    10,    11,
+      12,    -1,    -1,    30,    -1,    13,    14,    15,    16,    17,
+      18,    -1,    24,    21,    22,    -1,    -1,    -1,    30,    13,
+      14,    15,    16,    17,    18,    19,    20,    21,    22,    -1,
+      -1,    -1,    -1,    -1,    -1,    29,    13,    14,    15,    16,
+      17,    18,    19,    20,    21,    22,    -1,    -1,    -1,    -1,
+      -1,    -1,    29,    13,    14,    15,    16,    17,    18,    19,
+      20,    21,    22,    -1,    -1,    -1,    -1,    -1,    -1,    29,
+      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+      -1,    -1,    -1,    -1,    27,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    -1,    -1,    -1,    -1,    27,
+      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+      -1,    -1,    -1,    -1,    27,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    -1,    -1,    -1,    -1,    27,
+      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+      -1,    -1,    -1,    -1,    27,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    -1,    -1,    25,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    -1,    -1,
+      25,    13,    14,    15,    16,    17,    18,    19,    20,    21,
+      22,    -1,    -1,    25,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    33,    34,     0,     3,     5,     6,     7,     8,     9,
+      10,    11,    12,    24,    30,    35,    36,    40,    43,    44,
+      24,    12,    27,    44,    24,    24,    12,    37,    27,    12,
+      23,    24,    28,    44,    39,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    27,    44,    28,    27,    12,
+      41,    44,    27,    12,    28,    44,    44,    45,    44,    25,
+      31,    40,    44,    44,    44,    44,    44,    44,    44,    44,
+      44,    44,    25,    44,    23,    27,    25,    24,    44,    27,
+      25,    26,    29,    40,    29,    44,    44,    40,    12,    38,
+      29,    44,    23,     4,    27,    25,    26,    27,    44,    40,
+      12,    42,    43,    12,    27,    23,    25,    44,    40
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    32,    33,    34,    34,    35,    35,    37,    36,    38,
+      38,    38,    39,    39,    40,    40,    40,    40,    40,    40,
+      40,    40,    40,    40,    40,    40,    40,    41,    41,    42,
+      42,    43,    44,    44,    44,    44,    44,    44,    44,    44,
+      44,    44,    44,    44,    44,    44,    44,    45,    45,    45
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     0,     2,     1,     1,     0,     7,     0,
+       1,     3,     0,     2,     4,     3,     3,     2,     7,     5,
+       5,     9,     2,     6,     7,     1,     2,     3,     0,     3,
+       0,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     1,     1,     4,     4,     0,     1,     3
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
+    {
+    case YYSYMBOL_toplevel_list: /* toplevel_list  */
+#line 58 "parser.y"
+            { for (int i = 0; i < ((*yyvaluep).stmt_list_struct).count; i++) free_ast(((*yyvaluep).stmt_list_struct).stmts[i]); free(((*yyvaluep).stmt_list_struct).stmts); }
+#line 955 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_toplevel: /* toplevel  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 961 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_funcdef: /* funcdef  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 967 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_param_list: /* param_list  */
+#line 59 "parser.y"
+            { for (int i = 0; i < ((*yyvaluep).id_list_struct).count; i++) free(((*yyvaluep).id_list_struct).ids[i]); free(((*yyvaluep).id_list_struct).ids); }
+#line 973 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_stmt_list: /* stmt_list  */
+#line 58 "parser.y"
+            { for (int i = 0; i < ((*yyvaluep).stmt_list_struct).count; i++) free_ast(((*yyvaluep).stmt_list_struct).stmts[i]); free(((*yyvaluep).stmt_list_struct).stmts); }
+#line 979 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_statement: /* statement  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 985 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_for_init: /* for_init  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 991 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_for_inc: /* for_inc  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 997 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_block: /* block  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 1003 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_expr: /* expr  */
+#line 57 "parser.y"
+            { free_ast(((*yyvaluep).node)); }
+#line 1009 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_arg_list: /* arg_list  */
+#line 60 "parser.y"
+            { for (int i = 0; i < ((*yyvaluep).arg_list_struct).count; i++) free_ast(((*yyvaluep).arg_list_struct).args[i]); free(((*yyvaluep).arg_list_struct).args); }
+#line 1015 "parser.tab.c"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: toplevel_list  */
+#line 70 "parser.y"
+                  { root = new_block((yyvsp[0].stmt_list_struct).stmts, (yyvsp[0].stmt_list_struct).count); }
+#line 1285 "parser.tab.c"
+    break;
+
+  case 3: /* toplevel_list: %empty  */
+#line 74 "parser.y"
+                  { (yyval.stmt_list_struct).stmts = NULL; (yyval.stmt_list_struct).count = 0; }
+#line 1291 "parser.tab.c"
+    break;
+
+  case 4: /* toplevel_list: toplevel_list toplevel  */
+#line 75 "parser.y"
+                             {
+        (yyval.stmt_list_struct).stmts = realloc((yyvsp[-1].stmt_list_struct).stmts, sizeof(ASTNode*) * ((yyvsp[-1].stmt_list_struct).count + 1));
+        (yyval.stmt_list_struct).stmts[(yyvsp[-1].stmt_list_struct).count] = (yyvsp[0].node);
+        (yyval.stmt_list_struct).count = (yyvsp[-1].stmt_list_struct).count + 1;
+    }
+#line 1301 "parser.tab.c"
+    break;
+
+  case 5: /* toplevel: funcdef  */
+#line 83 "parser.y"
+              { (yyval.node) = (yyvsp[0].node); }
+#line 1307 "parser.tab.c"
+    break;
+
+  case 6: /* toplevel: statement  */
+#line 84 "parser.y"
+                { (yyval.node) = (yyvsp[0].node); }
+#line 1313 "parser.tab.c"
+    break;
+
+  case 7: /* @1: %empty  */
+#line 88 "parser.y"
+         { (yyval.num) = yylineno; }
+#line 1319 "parser.tab.c"
+    break;
+
+  case 8: /* funcdef: FUNC @1 ID '(' param_list ')' block  */
+#line 88 "parser.y"
+                                                             {
+        (yyval.node) = new_funcdef(lex_intern((yyvsp[-4].slice)), (yyvsp[-2].id_list_struct).ids, (yyvsp[-2].id_list_struct).count, (yyvsp[0].node));
+        (yyval.node)->line = (yyvsp[-5].num);
+    }
+#line 1328 "parser.tab.c"
+    break;
+
+  case 9: /* param_list: %empty  */
+#line 95 "parser.y"
+                  { (yyval.id_list_struct).ids = NULL; (yyval.id_list_struct).count = 0; }
+#line 1334 "parser.tab.c"
+    break;
+
+  case 10: /* param_list: ID  */
+#line 96 "parser.y"
+         { (yyval.id_list_struct).ids = malloc(sizeof(char*)); (yyval.id_list_struct).ids[0] = strdup(lex_intern((yyvsp[0].slice))); (yyval.id_list_struct).count = 1; }
+#line 1340 "parser.tab.c"
+    break;
+
+  case 11: /* param_list: param_list ',' ID  */
+#line 97 "parser.y"
+                        {
+        (yyval.id_list_struct).ids = realloc((yyvsp[-2].id_list_struct).ids, sizeof(char*) * ((yyvsp[-2].id_list_struct).count + 1));
+        (yyval.id_list_struct).ids[(yyvsp[-2].id_list_struct).count] = strdup(lex_intern((yyvsp[0].slice)));
+        (yyval.id_list_struct).count = (yyvsp[-2].id_list_struct).count + 1;
+    }
+#line 1350 "parser.tab.c"
+    break;
+
+  case 12: /* stmt_list: %empty  */
+#line 105 "parser.y"
+                  { (yyval.stmt_list_struct).stmts = NULL; (yyval.stmt_list_struct).count = 0; }
+#line 1356 "parser.tab.c"
+    break;
+
+  case 13: /* stmt_list: stmt_list statement  */
+#line 106 "parser.y"
+                          {
+        (yyval.stmt_list_struct).stmts = realloc((yyvsp[-1].stmt_list_struct).stmts, sizeof(ASTNode*) * ((yyvsp[-1].stmt_list_struct).count + 1));
+        (yyval.stmt_list_struct).stmts[(yyvsp[-1].stmt_list_struct).count] = (yyvsp[0].node);
+        (yyval.stmt_list_struct).count = (yyvsp[-1].stmt_list_struct).count + 1;
+    }
+#line 1366 "parser.tab.c"
+    break;
+
+  case 14: /* statement: ID '=' expr ';'  */
+#line 114 "parser.y"
+                    { (yyval.node) = new_assign(lex_intern((yyvsp[-3].slice)), (yyvsp[-1].node)); }
+#line 1372 "parser.tab.c"
+    break;
+
+  case 15: /* statement: PRINT ID ';'  */
+#line 115 "parser.y"
+                   { (yyval.node) = new_print(lex_intern((yyvsp[-1].slice))); }
+#line 1378 "parser.tab.c"
+    break;
+
+  case 16: /* statement: RETURN expr ';'  */
+#line 116 "parser.y"
+                      { (yyval.node) = new_return((yyvsp[-1].node)); }
+#line 1384 "parser.tab.c"
+    break;
+
+  case 17: /* statement: RETURN ';'  */
+#line 117 "parser.y"
+                 { (yyval.node) = new_return(NULL); }
+#line 1390 "parser.tab.c"
+    break;
+
+  case 18: /* statement: IF '(' expr ')' statement ELSE statement  */
+#line 118 "parser.y"
+                                               { (yyval.node) = new_if((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1396 "parser.tab.c"
+    break;
+
+  case 19: /* statement: IF '(' expr ')' statement  */
+#line 119 "parser.y"
+                                { (yyval.node) = new_if((yyvsp[-2].node), (yyvsp[0].node), NULL); }
+#line 1402 "parser.tab.c"
+    break;
+
+  case 20: /* statement: WHILE '(' expr ')' statement  */
+#line 120 "parser.y"
+                                   { (yyval.node) = new_while((yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1408 "parser.tab.c"
+    break;
+
+  case 21: /* statement: FOR '(' for_init ';' expr ';' for_inc ')' statement  */
+#line 121 "parser.y"
+                                                          { (yyval.node) = new_for((yyvsp[-6].node), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1414 "parser.tab.c"
+    break;
+
+  case 22: /* statement: BREAK ';'  */
+#line 122 "parser.y"
+                { (yyval.node) = new_break(); }
+#line 1420 "parser.tab.c"
+    break;
+
+  case 23: /* statement: ID ID '[' expr ']' ';'  */
+#line 123 "parser.y"
+                             {
+        // "array" is only a keyword here, so it stays usable as a name.
+        if (!lex_is((yyvsp[-5].slice), "array")) { yyerror("syntax error"); free_ast((yyvsp[-2].node)); YYERROR; }
+        (yyval.node) = new_array_decl(lex_intern((yyvsp[-4].slice)), (yyvsp[-2].node));
+    }
+#line 1430 "parser.tab.c"
+    break;
+
+  case 24: /* statement: ID '[' expr ']' '=' expr ';'  */
+#line 128 "parser.y"
+                                   { (yyval.node) = new_index_assign(lex_intern((yyvsp[-6].slice)), (yyvsp[-4].node), (yyvsp[-1].node)); }
+#line 1436 "parser.tab.c"
+    break;
+
+  case 26: /* statement: expr ';'  */
+#line 130 "parser.y"
+               { (yyval.node) = (yyvsp[-1].node); }
+#line 1442 "parser.tab.c"
+    break;
+
+  case 27: /* for_init: ID '=' expr  */
+#line 134 "parser.y"
+                { (yyval.node) = new_assign(lex_intern((yyvsp[-2].slice)), (yyvsp[0].node)); }
+#line 1448 "parser.tab.c"
+    break;
+
+  case 28: /* for_init: %empty  */
+#line 135 "parser.y"
+                  { (yyval.node) = NULL; }
+#line 1454 "parser.tab.c"
+    break;
+
+  case 29: /* for_inc: ID '=' expr  */
+#line 139 "parser.y"
+                { (yyval.node) = new_assign(lex_intern((yyvsp[-2].slice)), (yyvsp[0].node)); }
+#line 1460 "parser.tab.c"
+    break;
+
+  case 30: /* for_inc: %empty  */
+#line 140 "parser.y"
+                  { (yyval.node) = NULL; }
+#line 1466 "parser.tab.c"
+    break;
+
+  case 31: /* block: '{' stmt_list '}'  */
+#line 144 "parser.y"
+                      { (yyval.node) = new_block((yyvsp[-1].stmt_list_struct).stmts, (yyvsp[-1].stmt_list_struct).count); }
+#line 1472 "parser.tab.c"
+    break;
+
+  case 32: /* expr: expr '+' expr  */
+#line 148 "parser.y"
+                  { (yyval.node) = new_binop("+", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1478 "parser.tab.c"
+    break;
+
+  case 33: /* expr: expr '-' expr  */
+#line 149 "parser.y"
+                    { (yyval.node) = new_binop("-", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1484 "parser.tab.c"
+    break;
+
+  case 34: /* expr: expr '*' expr  */
+#line 150 "parser.y"
+                    { (yyval.node) = new_binop("*", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1490 "parser.tab.c"
+    break;
+
+  case 35: /* expr: expr '/' expr  */
+#line 151 "parser.y"
+                    { (yyval.node) = new_binop("/", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1496 "parser.tab.c"
+    break;
+
+  case 36: /* expr: expr EQ expr  */
+#line 152 "parser.y"
+                    { (yyval.node) = new_binop("==", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1502 "parser.tab.c"
+    break;
+
+  case 37: /* expr: expr NE expr  */
+#line 153 "parser.y"
+                    { (yyval.node) = new_binop("!=", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1508 "parser.tab.c"
+    break;
+
+  case 38: /* expr: expr LT expr  */
+#line 154 "parser.y"
+                    { (yyval.node) = new_binop("<", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1514 "parser.tab.c"
+    break;
+
+  case 39: /* expr: expr LE expr  */
+#line 155 "parser.y"
+                    { (yyval.node) = new_binop("<=", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1520 "parser.tab.c"
+    break;
+
+  case 40: /* expr: expr GT expr  */
+#line 156 "parser.y"
+                    { (yyval.node) = new_binop(">", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1526 "parser.tab.c"
+    break;
+
+  case 41: /* expr: expr GE expr  */
+#line 157 "parser.y"
+                    { (yyval.node) = new_binop(">=", (yyvsp[-2].node), (yyvsp[0].node)); }
+#line 1532 "parser.tab.c"
+    break;
+
+  case 42: /* expr: '(' expr ')'  */
+#line 158 "parser.y"
+                    { (yyval.node) = (yyvsp[-1].node); }
+#line 1538 "parser.tab.c"
+    break;
+
+  case 43: /* expr: NUMBER  */
+#line 159 "parser.y"
+                    { (yyval.node) = new_num((yyvsp[0].num)); }
+#line 1544 "parser.tab.c"
+    break;
+
+  case 44: /* expr: ID  */
+#line 160 "parser.y"
+                    { (yyval.node) = new_id(lex_intern((yyvsp[0].slice))); }
+#line 1550 "parser.tab.c"
+    break;
+
+  case 45: /* expr: ID '(' arg_list ')'  */
+#line 161 "parser.y"
+                          { (yyval.node) = new_funccall(lex_intern((yyvsp[-3].slice)), (yyvsp[-1].arg_list_struct).args, (yyvsp[-1].arg_list_struct).count); }
+#line 1556 "parser.tab.c"
+    break;
+
+  case 46: /* expr: ID '[' expr ']'  */
+#line 162 "parser.y"
+                      { (yyval.node) = new_index(lex_intern((yyvsp[-3].slice)), (yyvsp[-1].node)); }
+#line 1562 "parser.tab.c"
+    break;
+
+  case 47: /* arg_list: %empty  */
+#line 166 "parser.y"
+                  { (yyval.arg_list_struct).args = NULL; (yyval.arg_list_struct).count = 0; }
+#line 1568 "parser.tab.c"
+    break;
+
+  case 48: /* arg_list: expr  */
+#line 167 "parser.y"
+           { (yyval.arg_list_struct).args = malloc(sizeof(ASTNode*)); (yyval.arg_list_struct).args[0] = (yyvsp[0].node); (yyval.arg_list_struct).count = 1; }
+#line 1574 "parser.tab.c"
+    break;
+
+  case 49: /* arg_list: arg_list ',' expr  */
+#line 168 "parser.y"
+                        {
+        (yyval.arg_list_struct).args = realloc((yyvsp[-2].arg_list_struct).args, sizeof(ASTNode*) * ((yyvsp[-2].arg_list_struct).count + 1));
+        (yyval.arg_list_struct).args[(yyvsp[-2].arg_list_struct).count] = (yyvsp[0].node);
+        (yyval.arg_list_struct).count = (yyvsp[-2].arg_list_struct).count + 1;
+    }
+#line 1584 "parser.tab.c"
+    break;
+
+
+#line 1588 "parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 175 "parser.y"
+
+
+
+void yyerror(const char *s) {
+    snprintf(parse_error, sizeof(parse_error), "Parse error at line %d: %s", yylineno, s);
+}
+
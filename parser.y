@@ -1,20 +1,27 @@
 %code requires {
     #include "ast.h"
+    #include "lexer.h"
 }
 
 %{
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "ast.h"
 extern int yylex();
 void yyerror(const char *s);
 ASTNode *root = NULL;
+char parse_error[256]; // message from the last failed yyparse()
 extern int yylineno; // For error reporting
+
+// Nested input needs a deep parser stack; bison grows it on the heap.
+#define YYINITDEPTH 1024
+#define YYMAXDEPTH 50000000
 %}
 
 %union {
     int num;
-    char *id;
+    Slice slice;
     ASTNode *node;
     ASTNode **node_array;
     struct {
@@ -36,16 +43,22 @@ extern int yylineno; // For error reporting
 %token FUNC
 %token BREAK
 %token <num> NUMBER
-%token <id> ID
+%token <slice> ID
 %token EQ NE LT GT LE GE
 
-%type <node> program statement expr block for_init for_inc funcdef
+%type <node> statement expr block for_init for_inc funcdef
 %type <stmt_list_struct> stmt_list
 %type <id_list_struct> param_list
 %type <arg_list_struct> arg_list
 %type <stmt_list_struct> toplevel_list
 %type <node> toplevel
 
+// Values bison drops when a parse fails; an accepted parse hands them to root.
+%destructor { free_ast($$); } <node>
+%destructor { for (int i = 0; i < $$.count; i++) free_ast($$.stmts[i]); free($$.stmts); } <stmt_list_struct>
+%destructor { for (int i = 0; i < $$.count; i++) free($$.ids[i]); free($$.ids); } <id_list_struct>
+%destructor { for (int i = 0; i < $$.count; i++) free_ast($$.args[i]); free($$.args); } <arg_list_struct>
+
 %left '+' '-'
 %left '*' '/'
 %left EQ NE LT GT LE GE
@@ -72,18 +85,18 @@ toplevel:
     ;
 
 funcdef:
-    FUNC ID '(' param_list ')' block {
-        $$ = new_funcdef($2, $4.ids, $4.count, $6);
-        free($2);
+    FUNC { $<num>$ = yylineno; } ID '(' param_list ')' block {
+        $$ = new_funcdef(lex_intern($3), $5.ids, $5.count, $7);
+        $$->line = $<num>2;
     }
     ;
 
 param_list:
       /* empty */ { $$.ids = NULL; $$.count = 0; }
-    | ID { $$.ids = malloc(sizeof(char*)); $$.ids[0] = $1; $$.count = 1; }
+    | ID { $$.ids = malloc(sizeof(char*)); $$.ids[0] = strdup(lex_intern($1)); $$.count = 1; }
     | param_list ',' ID {
         $$.ids = realloc($1.ids, sizeof(char*) * ($1.count + 1));
-        $$.ids[$1.count] = $3;
+        $$.ids[$1.count] = strdup(lex_intern($3));
         $$.count = $1.count + 1;
     }
     ;
@@ -98,8 +111,8 @@ stmt_list:
     ;
 
 statement:
-    ID '=' expr ';' { $$ = new_assign($1, $3); free($1); }
-    | PRINT ID ';' { $$ = new_print($2); free($2); }
+    ID '=' expr ';' { $$ = new_assign(lex_intern($1), $3); }
+    | PRINT ID ';' { $$ = new_print(lex_intern($2)); }
     | RETURN expr ';' { $$ = new_return($2); }
     | RETURN ';' { $$ = new_return(NULL); }
     | IF '(' expr ')' statement ELSE statement { $$ = new_if($3, $5, $7); }
@@ -107,17 +120,23 @@ statement:
     | WHILE '(' expr ')' statement { $$ = new_while($3, $5); }
     | FOR '(' for_init ';' expr ';' for_inc ')' statement { $$ = new_for($3, $5, $7, $9); }
     | BREAK ';' { $$ = new_break(); }
+    | ID ID '[' expr ']' ';' {
+        // "array" is only a keyword here, so it stays usable as a name.
+        if (!lex_is($1, "array")) { yyerror("syntax error"); free_ast($4); YYERROR; }
+        $$ = new_array_decl(lex_intern($2), $4);
+    }
+    | ID '[' expr ']' '=' expr ';' { $$ = new_index_assign(lex_intern($1), $3, $6); }
     | block
     | expr ';' { $$ = $1; } // For function calls as statements
     ;
 
 for_init:
-    ID '=' expr { $$ = new_assign($1, $3); free($1); }
+    ID '=' expr { $$ = new_assign(lex_intern($1), $3); }
     | /* empty */ { $$ = NULL; }
     ;
 
 for_inc:
-    ID '=' expr { $$ = new_assign($1, $3); free($1); }
+    ID '=' expr { $$ = new_assign(lex_intern($1), $3); }
     | /* empty */ { $$ = NULL; }
     ;
 
@@ -138,8 +157,9 @@ expr:
     | expr GE expr  { $$ = new_binop(">=", $1, $3); }
     | '(' expr ')'  { $$ = $2; }
     | NUMBER        { $$ = new_num($1); }
-    | ID            { $$ = new_id($1); free($1); }
-    | ID '(' arg_list ')' { $$ = new_funccall($1, $3.args, $3.count); free($1); }
+    | ID            { $$ = new_id(lex_intern($1)); }
+    | ID '(' arg_list ')' { $$ = new_funccall(lex_intern($1), $3.args, $3.count); }
+    | ID '[' expr ']' { $$ = new_index(lex_intern($1), $3); }
     ;
 
 arg_list:
@@ -156,6 +176,6 @@ arg_list:
 
 
 void yyerror(const char *s) {
-    fprintf(stderr, "Parse error at line %d: %s\n", yylineno, s);
+    snprintf(parse_error, sizeof(parse_error), "Parse error at line %d: %s", yylineno, s);
 }
 
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "passes.h"
+#include "vectorize.h"
+#include "parallel.h"
+
+// --- Registry ---
+typedef struct {
+    const char *name;
+    int min_level; // first -O level that runs the pass
+    int per_round; // rewrites the tree, so runs every round
+} PassInfo;
+
+static const PassInfo passes[PASS_COUNT] = {
+    [PASS_DEAD_FUNCTIONS] = { "dead-functions", 2, 1 },
+    [PASS_FOLD]           = { "fold",           1, 1 },
+    [PASS_DCE]            = { "dce",            1, 1 },
+    [PASS_VECTORIZE]      = { "vectorize",      2, 0 },
+    [PASS_PARALLELIZE]    = { "parallelize",    2, 0 },
+};
+
+// -O0: nothing. -O1: fold and DCE. -O2: every pass, one round.
+// -O3: every pass, rounds until nothing changes.
+void pass_options_init(PassOptions *opts, int level) {
+    opts->level = level;
+    opts->enabled = 0;
+    for (int i = 0; i < PASS_COUNT; i++)
+        if (level >= passes[i].min_level) opts->enabled |= 1u << i;
+    opts->max_rounds = level >= 3 ? PASS_MAX_ROUNDS : 1;
+    opts->keep_globals = 0;
+}
+
+int pass_lookup(const char *name, size_t len) {
+    for (int i = 0; i < PASS_COUNT; i++)
+        if (strlen(passes[i].name) == len && memcmp(passes[i].name, name, len) == 0) return i;
+    return -1;
+}
+
+const char *pass_name(int id) {
+    return passes[id].name;
+}
+
+// Distinguishes trees optimised with different options in the cache
+uint64_t pass_options_key(const PassOptions *opts) {
+    uint64_t key = (uint64_t)opts->enabled << 32 | (uint32_t)opts->max_rounds << 1 | (opts->keep_globals != 0);
+    return key * 0x9E3779B97F4A7C15ULL;
+}
+
+// --- Running passes ---
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static PassPlan *new_plan(const PassOptions *opts) {
+    PassPlan *plan = calloc(1, sizeof(PassPlan));
+    plan->refs = 1;
+    plan->opts = *opts;
+    return plan;
+}
+
+void pass_plan_release(PassPlan *plan) {
+    if (!plan || --plan->refs > 0) return;
+    used_free(plan->used);
+    free(plan);
+}
+
+static int enabled(const PassPlan *plan, PassId id) {
+    return (plan->opts.enabled >> id) & 1;
+}
+
+// Run one pass over *node, if enabled, and return the nodes it removed.
+// plan->used is replaced by DCE, which collects it first.
+static long run_pass(PassPlan *plan, PassId id, ASTNode **node) {
+    if (!enabled(plan, id)) return 0;
+    PassStats *stats = &plan->stats[id];
+    long removed = stats->removed;
+    double start = now();
+    switch (id) {
+        case PASS_DEAD_FUNCTIONS:
+            eliminate_dead_functions(*node, stats);
+            break;
+        case PASS_FOLD:
+            *node = fold_constants(*node, stats);
+            break;
+        case PASS_DCE:
+            used_free(plan->used);
+            plan->used = collect_used_vars(*node, plan->opts.keep_globals, stats);
+            *node = eliminate_dead_assignments(plan->used, *node, stats);
+            break;
+        case PASS_VECTORIZE:
+            vectorize_loops(*node, stats);
+            break;
+        case PASS_PARALLELIZE:
+            parallelize_loops(*node, stats);
+            break;
+        default:
+            break;
+    }
+    stats->runs++;
+    stats->seconds += now() - start;
+    return stats->removed - removed;
+}
+
+// Hand the plan to every function definition still to be compiled
+static void attach_plan(ASTNode *root, PassPlan *plan) {
+    if (!root || root->type != NODE_BLOCK) return;
+    for (int i = 0; i < root->data.block.count; i++) {
+        ASTNode *stmt = root->data.block.statements[i];
+        if (stmt->type != NODE_FUNCDEF || stmt->data.funcdef.compiled) continue;
+        plan->refs++;
+        pass_plan_release(stmt->data.funcdef.plan);
+        stmt->data.funcdef.plan = plan;
+    }
+}
+
+// The root is rewritten in place: a program's root is always a block.
+PassPlan *passes_run(ASTNode *root, const PassOptions *opts) {
+    PassPlan *plan = new_plan(opts);
+    long removed;
+    do {
+        removed = 0;
+        for (int id = 0; id < PASS_COUNT; id++)
+            if (passes[id].per_round) removed += run_pass(plan, id, &root);
+        plan->rounds++;
+    } while (removed && plan->rounds < plan->opts.max_rounds);
+    attach_plan(root, plan);
+    for (int id = 0; id < PASS_COUNT; id++)
+        if (!passes[id].per_round) run_pass(plan, id, &root);
+    return plan;
+}
+
+PassPlan *passes_run_cached(ASTNode *root, const PassOptions *opts) {
+    PassPlan *plan = new_plan(opts);
+    plan->loops_only = 1;
+    attach_plan(root, plan);
+    for (int id = 0; id < PASS_COUNT; id++)
+        if (!passes[id].per_round) run_pass(plan, id, &root);
+    return plan;
+}
+
+void optimise_ast(ASTNode *root) {
+    PassOptions opts;
+    pass_options_init(&opts, PASS_DEFAULT_LEVEL);
+    pass_plan_release(passes_run(root, &opts));
+}
+
+// --- Lazy function compilation ---
+// Function bodies are optimised the first time they are needed: when called,
+// or when lowered to intermediate code. Interpreter threads may race to it.
+// A body gets one round: DCE uses the program's set, which cannot shrink.
+static pthread_mutex_t function_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void compile_function(ASTNode *def) {
+    if (__atomic_load_n(&def->data.funcdef.compiled, __ATOMIC_ACQUIRE)) return;
+    pthread_mutex_lock(&function_lock);
+    PassPlan *plan = def->data.funcdef.plan;
+    if (!def->data.funcdef.compiled && plan) {
+        ASTNode **body = &def->data.funcdef.body;
+        if (!plan->loops_only) {
+            run_pass(plan, PASS_FOLD, body);
+            if (enabled(plan, PASS_DCE) && plan->used) {
+                PassStats *stats = &plan->stats[PASS_DCE];
+                double start = now();
+                *body = eliminate_dead_assignments(plan->used, *body, stats);
+                stats->runs++;
+                stats->seconds += now() - start;
+            }
+        }
+        for (int id = 0; id < PASS_COUNT; id++)
+            if (!passes[id].per_round) run_pass(plan, id, body);
+        def->data.funcdef.plan = NULL;
+        pass_plan_release(plan);
+    }
+    __atomic_store_n(&def->data.funcdef.compiled, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&function_lock);
+}
+
+void compile_all_functions(ASTNode *root) {
+    if (!root || root->type != NODE_BLOCK) return;
+    for (int i = 0; i < root->data.block.count; i++)
+        if (root->data.block.statements[i]->type == NODE_FUNCDEF)
+            compile_function(root->data.block.statements[i]);
+}
+
+// --- Report ---
+// Function bodies add to the figures as they are compiled, so a report taken
+// after the program ran covers everything that was optimised.
+void passes_report(FILE *out, const PassPlan *plan) {
+    if (plan->loops_only)
+        fprintf(out, "--- Pass statistics (-O%d, cached) ---\n", plan->opts.level);
+    else
+        fprintf(out, "--- Pass statistics (-O%d, %d round%s) ---\n", plan->opts.level,
+                plan->rounds, plan->rounds == 1 ? "" : "s");
+    fprintf(out, "%-16s %6s %10s %10s %10s\n", "pass", "runs", "visited", "removed", "ms");
+    for (int id = 0; id < PASS_COUNT; id++) {
+        const PassStats *st = &plan->stats[id];
+        if (!enabled(plan, id)) {
+            fprintf(out, "%-16s %6s\n", passes[id].name, "off");
+            continue;
+        }
+        fprintf(out, "%-16s %6ld %10ld %10ld %10.3f\n", passes[id].name, st->runs,
+                st->visited, st->removed, st->seconds * 1000);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef PASSES_H
+#define PASSES_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "ast.h"
+
+// Optimisation pipeline. The tree-rewriting passes run in rounds until a
+// round removes nothing or the round cap is hit; the loop planners run once
+// afterwards. Function bodies are optimised on first use (compile_function())
+// by the same pipeline, against the program's final used-variable set.
+typedef enum {
+    PASS_DEAD_FUNCTIONS,
+    PASS_FOLD,
+    PASS_DCE,
+    PASS_VECTORIZE,
+    PASS_PARALLELIZE,
+    PASS_COUNT
+} PassId;
+
+#define PASS_DEFAULT_LEVEL 2
+#define PASS_MAX_ROUNDS 8
+
+struct PassStats {
+    long runs;
+    long visited; // nodes examined
+    long removed; // nodes freed, net of any replacements
+    double seconds;
+};
+
+typedef struct {
+    int level;        // -O level, 0-3
+    unsigned enabled; // 1 << PassId
+    int max_rounds;
+    int keep_globals; // assigned variables count as used: the host may read them
+} PassOptions;
+
+// What a program's passes left to do, shared by the function definitions
+// that have not been compiled yet.
+struct PassPlan {
+    int refs;
+    PassOptions opts;
+    UsedVars *used;  // for function bodies; NULL without DCE
+    int loops_only;  // bodies were optimised before (cached trees)
+    int rounds;
+    PassStats stats[PASS_COUNT];
+};
+
+void pass_options_init(PassOptions *opts, int level);
+int pass_lookup(const char *name, size_t len); // PassId, or -1
+const char *pass_name(int id);
+uint64_t pass_options_key(const PassOptions *opts);
+
+PassPlan *passes_run(ASTNode *root, const PassOptions *opts);
+PassPlan *passes_run_cached(ASTNode *root, const PassOptions *opts); // loop planners only
+void pass_plan_release(PassPlan *plan);
+void passes_report(FILE *out, const PassPlan *plan);
+
+void compile_function(ASTNode *def);
+void compile_all_functions(ASTNode *root);
+
+#endif
@@ -0,0 +1,305 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "profile.h"
+
+int profile_enabled = 0;
+
+// --- Timer ---
+#if defined(__x86_64__) || defined(__i386__)
+#define TIME_UNIT "cycles"
+static inline uint64_t read_timer(void) {
+    return __rdtsc();
+}
+#else
+#define TIME_UNIT "ns"
+static inline uint64_t read_timer(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+// --- Per-node counters (open addressing, keyed by node address) ---
+typedef struct {
+    ASTNode *node;
+    uint64_t hits;
+    uint64_t iterations;
+    uint64_t self_cycles;
+    uint64_t total_cycles;
+    int active; // recursion depth, so nested activations are not double counted
+} NodeStats;
+
+static NodeStats *node_stats = NULL;
+static size_t node_stats_cap = 0;
+static size_t node_stats_used = 0;
+
+static size_t hash_ptr(const void *p) {
+    uintptr_t x = (uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+static NodeStats *node_slot(ASTNode *node) {
+    if (node_stats_used * 2 >= node_stats_cap) {
+        size_t old_cap = node_stats_cap;
+        NodeStats *old = node_stats;
+        node_stats_cap = old_cap ? old_cap * 2 : 256;
+        node_stats = calloc(node_stats_cap, sizeof(NodeStats));
+        node_stats_used = 0;
+        for (size_t i = 0; i < old_cap; i++) {
+            if (old[i].node) {
+                *node_slot(old[i].node) = old[i];
+                node_stats_used++;
+            }
+        }
+        free(old);
+    }
+    size_t i = hash_ptr(node) & (node_stats_cap - 1);
+    while (node_stats[i].node && node_stats[i].node != node)
+        i = (i + 1) & (node_stats_cap - 1);
+    if (!node_stats[i].node) {
+        node_stats[i].node = node;
+        node_stats_used++;
+    }
+    return &node_stats[i];
+}
+
+// --- String-keyed counters, used for functions and folded stacks ---
+typedef struct {
+    char *key;
+    uint64_t count;
+    uint64_t self_cycles;
+    uint64_t total_cycles;
+    int active;
+} NamedStats;
+
+typedef struct {
+    NamedStats *slots;
+    size_t cap;
+    size_t used;
+} NamedTable;
+
+static NamedTable func_stats;
+static NamedTable folded_stats;
+
+static size_t hash_str(const char *s, size_t len) {
+    size_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static NamedStats *named_slot(NamedTable *t, const char *key, size_t len) {
+    if (t->used * 2 >= t->cap) {
+        NamedTable old = *t;
+        t->cap = old.cap ? old.cap * 2 : 64;
+        t->slots = calloc(t->cap, sizeof(NamedStats));
+        t->used = 0;
+        for (size_t i = 0; i < old.cap; i++) {
+            if (old.slots[i].key) {
+                size_t j = hash_str(old.slots[i].key, strlen(old.slots[i].key)) & (t->cap - 1);
+                while (t->slots[j].key) j = (j + 1) & (t->cap - 1);
+                t->slots[j] = old.slots[i];
+                t->used++;
+            }
+        }
+        free(old.slots);
+    }
+    size_t i = hash_str(key, len) & (t->cap - 1);
+    while (t->slots[i].key) {
+        if (strlen(t->slots[i].key) == len && memcmp(t->slots[i].key, key, len) == 0)
+            return &t->slots[i];
+        i = (i + 1) & (t->cap - 1);
+    }
+    t->slots[i].key = strndup(key, len);
+    t->used++;
+    return &t->slots[i];
+}
+
+// --- Folded stack path ("main;func;for@12") ---
+static char *stack_path = NULL;
+static int stack_len = 0;
+static int stack_cap = 0;
+
+// --- Active node stack ---
+typedef struct {
+    ASTNode *node;
+    uint64_t start;
+    uint64_t child_cycles;
+    int stack_len; // length of the folded-stack path before this frame
+} ProfileFrame;
+
+static ProfileFrame *frames = NULL;
+static int frame_count = 0;
+static int frame_cap = 0;
+
+static void stack_append(const char *name, int line) {
+    char buf[64];
+    int extra = line ? snprintf(buf, sizeof(buf), "@%d", line) : 0;
+    int need = stack_len + 1 + (int)strlen(name) + extra + 1;
+    if (need > stack_cap) {
+        stack_cap = need * 2;
+        stack_path = realloc(stack_path, stack_cap);
+    }
+    stack_len += sprintf(stack_path + stack_len, "%s%s%s", stack_len ? ";" : "", name, line ? buf : "");
+}
+
+static int is_stack_node(ASTNode *node) {
+    return node->type == NODE_FUNCCALL || node->type == NODE_WHILE || node->type == NODE_FOR;
+}
+
+// --- Hooks called from interpret() ---
+void profile_enter(ASTNode *node) {
+    if (!stack_path) stack_append("main", 0);
+    if (frame_count == frame_cap) {
+        frame_cap = frame_cap ? frame_cap * 2 : 64;
+        frames = realloc(frames, sizeof(ProfileFrame) * frame_cap);
+    }
+    ProfileFrame *frame = &frames[frame_count++];
+    frame->node = node;
+    frame->child_cycles = 0;
+    frame->stack_len = stack_len;
+
+    NodeStats *ns = node_slot(node);
+    ns->hits++;
+    ns->active++;
+    if (node->type == NODE_FUNCCALL) {
+        const char *name = node->data.funccall.name;
+        NamedStats *fs = named_slot(&func_stats, name, strlen(name));
+        fs->count++;
+        fs->active++;
+        stack_append(name, 0);
+    } else if (node->type == NODE_WHILE) {
+        stack_append("while", node->line);
+    } else if (node->type == NODE_FOR) {
+        stack_append("for", node->line);
+    }
+    frame->start = read_timer();
+}
+
+void profile_exit(void) {
+    ProfileFrame *frame = &frames[--frame_count];
+    uint64_t elapsed = read_timer() - frame->start;
+    uint64_t self = elapsed > frame->child_cycles ? elapsed - frame->child_cycles : 0;
+    ASTNode *node = frame->node;
+
+    NodeStats *ns = node_slot(node);
+    ns->self_cycles += self;
+    if (--ns->active == 0) ns->total_cycles += elapsed;
+
+    if (node->type == NODE_FUNCCALL) {
+        const char *name = node->data.funccall.name;
+        NamedStats *fs = named_slot(&func_stats, name, strlen(name));
+        if (--fs->active == 0) fs->total_cycles += elapsed;
+    }
+
+    named_slot(&folded_stats, stack_path, stack_len)->self_cycles += self;
+    if (is_stack_node(node)) stack_path[stack_len = frame->stack_len] = '\0';
+
+    if (frame_count) frames[frame_count - 1].child_cycles += elapsed;
+}
+
+void profile_loop_iteration(ASTNode *loop) {
+    node_slot(loop)->iterations++;
+}
+
+// --- Report ---
+typedef struct {
+    int line;
+    uint64_t hits;
+    uint64_t self_cycles;
+    uint64_t total_cycles;
+} LineStats;
+
+static int cmp_line_self(const void *a, const void *b) {
+    const LineStats *x = a, *y = b;
+    return (y->self_cycles > x->self_cycles) - (y->self_cycles < x->self_cycles);
+}
+
+static int cmp_node_total(const void *a, const void *b) {
+    const NodeStats *x = *(NodeStats *const *)a, *y = *(NodeStats *const *)b;
+    return (y->total_cycles > x->total_cycles) - (y->total_cycles < x->total_cycles);
+}
+
+static int cmp_named_total(const void *a, const void *b) {
+    const NamedStats *x = *(NamedStats *const *)a, *y = *(NamedStats *const *)b;
+    return (y->total_cycles > x->total_cycles) - (y->total_cycles < x->total_cycles);
+}
+
+#define PROFILE_TOP 10
+
+void profile_report(FILE *out, const char *folded_path) {
+    int max_line = 0;
+    for (size_t i = 0; i < node_stats_cap; i++)
+        if (node_stats[i].node && node_stats[i].node->line > max_line)
+            max_line = node_stats[i].node->line;
+
+    // Statements, aggregated per source line (blocks are only containers)
+    LineStats *lines = calloc(max_line + 1, sizeof(LineStats));
+    NodeStats **loops = malloc(sizeof(NodeStats *) * (node_stats_used + 1));
+    int loop_count = 0;
+    for (size_t i = 0; i < node_stats_cap; i++) {
+        NodeStats *ns = &node_stats[i];
+        if (!ns->node || ns->node->type == NODE_BLOCK || ns->node->type == NODE_FUNCDEF) continue;
+        LineStats *ls = &lines[ns->node->line];
+        ls->line = ns->node->line;
+        ls->hits += ns->hits;
+        ls->self_cycles += ns->self_cycles;
+        ls->total_cycles += ns->total_cycles;
+        if (ns->node->type == NODE_WHILE || ns->node->type == NODE_FOR)
+            loops[loop_count++] = ns;
+    }
+    qsort(lines, max_line + 1, sizeof(LineStats), cmp_line_self);
+    qsort(loops, loop_count, sizeof(NodeStats *), cmp_node_total);
+
+    NamedStats **funcs = malloc(sizeof(NamedStats *) * (func_stats.used + 1));
+    int func_count = 0;
+    for (size_t i = 0; i < func_stats.cap; i++)
+        if (func_stats.slots[i].key) funcs[func_count++] = &func_stats.slots[i];
+    qsort(funcs, func_count, sizeof(NamedStats *), cmp_named_total);
+
+    fprintf(out, "\n--- Profile (%s) ---\n", TIME_UNIT);
+    fprintf(out, "Hottest lines:\n%8s %12s %16s %16s\n", "line", "hits", "self", "total");
+    for (int i = 0; i < PROFILE_TOP && i <= max_line && lines[i].hits; i++)
+        fprintf(out, "%8d %12llu %16llu %16llu\n", lines[i].line, (unsigned long long)lines[i].hits,
+                (unsigned long long)lines[i].self_cycles, (unsigned long long)lines[i].total_cycles);
+
+    fprintf(out, "Hottest loops:\n%8s %-6s %10s %12s %16s\n", "line", "kind", "entries", "iterations", "total");
+    for (int i = 0; i < PROFILE_TOP && i < loop_count; i++)
+        fprintf(out, "%8d %-6s %10llu %12llu %16llu\n", loops[i]->node->line,
+                loops[i]->node->type == NODE_FOR ? "for" : "while",
+                (unsigned long long)loops[i]->hits, (unsigned long long)loops[i]->iterations,
+                (unsigned long long)loops[i]->total_cycles);
+
+    fprintf(out, "Hottest functions:\n%-20s %10s %16s\n", "name", "calls", "total");
+    for (int i = 0; i < PROFILE_TOP && i < func_count; i++)
+        fprintf(out, "%-20s %10llu %16llu\n", funcs[i]->key, (unsigned long long)funcs[i]->count,
+                (unsigned long long)funcs[i]->total_cycles);
+
+    if (folded_path) {
+        FILE *f = fopen(folded_path, "w");
+        if (!f) {
+            perror("fopen");
+        } else {
+            for (size_t i = 0; i < folded_stats.cap; i++)
+                if (folded_stats.slots[i].key && folded_stats.slots[i].self_cycles)
+                    fprintf(f, "%s %llu\n", folded_stats.slots[i].key,
+                            (unsigned long long)folded_stats.slots[i].self_cycles);
+            fclose(f);
+            fprintf(out, "Folded stacks written to %s\n", folded_path);
+        }
+    }
+
+    free(lines);
+    free(loops);
+    free(funcs);
+}
@@ -0,0 +1,17 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "ast.h"
+
+extern int profile_enabled;
+
+// Activations nest: every profile_enter() is matched by a profile_exit() for
+// the same node, innermost first.
+void profile_enter(ASTNode *node);
+void profile_exit(void);
+void profile_loop_iteration(ASTNode *loop);
+void profile_report(FILE *out, const char *folded_path);
+
+#endif
@@ -0,0 +1,102 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include "sched.h"
+
+struct Scheduler {
+    pthread_mutex_t lock;
+    pthread_cond_t work;   // queue became non-empty, or stopping
+    pthread_cond_t idle;   // pending dropped to zero
+    Interp **queue;        // ring buffer of runnable instances
+    int head;
+    int count;
+    int capacity;
+    int pending;           // submitted and not yet finished
+    int stopping;
+    long quantum;
+    pthread_t *threads;
+    int thread_count;
+};
+
+// Called with the lock held
+static void enqueue(Scheduler *s, Interp *in) {
+    if (s->count == s->capacity) {
+        int capacity = s->capacity ? s->capacity * 2 : 64;
+        Interp **queue = malloc(sizeof(Interp *) * capacity);
+        for (int i = 0; i < s->count; i++)
+            queue[i] = s->queue[(s->head + i) % s->capacity];
+        free(s->queue);
+        s->queue = queue;
+        s->head = 0;
+        s->capacity = capacity;
+    }
+    s->queue[(s->head + s->count) % s->capacity] = in;
+    s->count++;
+    pthread_cond_signal(&s->work);
+}
+
+static Interp *dequeue(Scheduler *s) {
+    Interp *in = s->queue[s->head];
+    s->head = (s->head + 1) % s->capacity;
+    s->count--;
+    return in;
+}
+
+static void *worker_main(void *arg) {
+    Scheduler *s = arg;
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->count && !s->stopping) pthread_cond_wait(&s->work, &s->lock);
+        if (!s->count) break;
+        Interp *in = dequeue(s);
+        pthread_mutex_unlock(&s->lock);
+        InterpStatus status = interp_run(in, s->quantum);
+        pthread_mutex_lock(&s->lock);
+        if (status == INTERP_READY) enqueue(s, in);
+        else if (--s->pending == 0) pthread_cond_broadcast(&s->idle);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+Scheduler *sched_new(int workers, long quantum) {
+    Scheduler *s = calloc(1, sizeof(Scheduler));
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->work, NULL);
+    pthread_cond_init(&s->idle, NULL);
+    s->quantum = quantum > 0 ? quantum : 1;
+    if (workers < 1) workers = 1;
+    s->threads = malloc(sizeof(pthread_t) * workers);
+    for (int i = 0; i < workers; i++) {
+        if (pthread_create(&s->threads[s->thread_count], NULL, worker_main, s) != 0) break;
+        s->thread_count++;
+    }
+    return s;
+}
+
+void sched_submit(Scheduler *s, Interp *in) {
+    pthread_mutex_lock(&s->lock);
+    s->pending++;
+    enqueue(s, in);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void sched_wait(Scheduler *s) {
+    pthread_mutex_lock(&s->lock);
+    while (s->pending) pthread_cond_wait(&s->idle, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void sched_free(Scheduler *s) {
+    pthread_mutex_lock(&s->lock);
+    s->stopping = 1;
+    pthread_cond_broadcast(&s->work);
+    pthread_mutex_unlock(&s->lock);
+    for (int i = 0; i < s->thread_count; i++)
+        pthread_join(s->threads[i], NULL);
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->work);
+    pthread_cond_destroy(&s->idle);
+    free(s->threads);
+    free(s->queue);
+    free(s);
+}
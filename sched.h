@@ -0,0 +1,17 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "interp.h"
+
+// A fixed pool of worker threads sharing one run queue of interpreter
+// instances. Each instance runs for at most `quantum` steps and then goes to
+// the back of the queue, so a few threads can interleave many programs and a
+// runaway loop only delays the others until its fuel runs out.
+typedef struct Scheduler Scheduler;
+
+Scheduler *sched_new(int workers, long quantum);
+void sched_submit(Scheduler *s, Interp *in);
+void sched_wait(Scheduler *s); // until every submitted instance has finished
+void sched_free(Scheduler *s);
+
+#endif
@@ -0,0 +1,53 @@
+// mc_compile() and mc_compile_file() fail with a NULL program and a message
+// saying why, and the compiler is usable again afterwards.
+#include <stdio.h>
+#include <string.h>
+#include "../minicompiler.h"
+
+static int failures = 0;
+
+static void expect_error(const char *what, const char *source, const mc_options *opts, const char *want) {
+    char err[256] = "";
+    mc_program *prog = mc_compile(source, strlen(source), opts, err, sizeof(err));
+    if (prog || !strstr(err, want)) {
+        printf("compile_errors: %s: got %s \"%s\", expected \"%s\"\n", what,
+               prog ? "a program and" : "NULL and", err, want);
+        failures++;
+    }
+    mc_program_free(prog);
+}
+
+int main(void) {
+    expect_error("syntax error", "x = 1;\ny = (2 + ;\n", NULL, "Parse error at line 2");
+    expect_error("unterminated block", "while (x < 3) {\n", NULL, "Parse error");
+    expect_error("declaration keyword", "x = 1;\nlist b[2];\n", NULL, "Parse error at line 2");
+
+    mc_options bad_level = { 0, NULL, 9, NULL };
+    expect_error("optimisation level", "x = 1;\n", &bad_level, "Unknown optimisation level: 9");
+    mc_options bad_pass = { 0, NULL, MC_OPT_DEFAULT, "fold,no-such-pass" };
+    expect_error("pass name", "x = 1;\n", &bad_pass, "Unknown pass: no-such-pass");
+
+    char err[256] = "";
+    mc_program *prog = mc_compile_file("tests/no-such-file.txt", NULL, err, sizeof(err));
+    if (prog || !strstr(err, "tests/no-such-file.txt: ")) {
+        printf("compile_errors: missing file: got \"%s\"\n", err);
+        failures++;
+    }
+    mc_program_free(prog);
+
+    // A failed parse leaves nothing behind for the next compile; "array"
+    // only declares when a name and a size follow it
+    const char *good = "array = 6;\narray b[2];\nb[1] = array * 7;\nx = b[1];\n";
+    prog = mc_compile(good, strlen(good), NULL, err, sizeof(err));
+    int x = 0;
+    mc_context *ctx = prog ? mc_context_new(prog) : NULL;
+    if (!ctx || mc_run(ctx) != MC_OK || !mc_get_var(ctx, "x", &x) || x != 42) {
+        printf("compile_errors: compile after errors: x = %d\n", x);
+        failures++;
+    }
+    mc_context_free(ctx);
+    mc_program_free(prog);
+
+    printf("compile_errors: %d failures\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,60 @@
+// Several host threads, each running its own context of one program, with
+// the parallel loop pool enabled. Every run must get the single-threaded sum.
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "../minicompiler.h"
+
+#define THREADS 4
+#define RUNS 200
+
+static const char *source =
+    "n = 20000;\n"
+    "array a[20000];\n"
+    "for (i = 0; i < n; i = i + 1) a[i] = i * 3 + 1;\n"
+    "s = 0;\n"
+    "for (i = 0; i < n; i = i + 1) s = s + a[i];\n";
+
+static mc_program *prog;
+static int expected;
+
+static int run_once(void) {
+    mc_context *ctx = mc_context_new(prog);
+    mc_enable_fast_loops(ctx, 1);
+    int s = 0;
+    if (mc_run(ctx) != MC_OK || !mc_get_var(ctx, "s", &s)) s = -1;
+    mc_context_free(ctx);
+    return s;
+}
+
+static void *worker(void *arg) {
+    long *failures = arg;
+    for (int i = 0; i < RUNS; i++)
+        if (run_once() != expected) (*failures)++;
+    return NULL;
+}
+
+int main(void) {
+    char err[256];
+    prog = mc_compile(source, strlen(source), NULL, err, sizeof(err));
+    if (!prog) {
+        printf("compile failed: %s\n", err);
+        return 1;
+    }
+    mc_set_threads(1, 1000);
+    expected = run_once();
+
+    mc_set_threads(4, 1000);
+    pthread_t threads[THREADS];
+    long failures[THREADS] = {0};
+    for (int i = 0; i < THREADS; i++)
+        pthread_create(&threads[i], NULL, worker, &failures[i]);
+    long total = 0;
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        total += failures[i];
+    }
+    mc_program_free(prog);
+    printf("concurrent_contexts: %ld of %d runs wrong (expected s = %d)\n", total, THREADS * RUNS, expected);
+    return total != 0;
+}
@@ -0,0 +1,57 @@
+// Limits set on a context hold for every run, not only the first: a context
+// killed by its memory cap or fuel, or stopped by a runtime error, is killed
+// the same way when run again.
+#include <stdio.h>
+#include <string.h>
+#include "../minicompiler.h"
+
+static int failures = 0;
+
+static mc_program *compile(const char *source) {
+    char err[256];
+    mc_program *prog = mc_compile(source, strlen(source), NULL, err, sizeof(err));
+    if (!prog) printf("repeated_runs: compile failed: %s\n", err);
+    return prog;
+}
+
+static void expect(const char *what, int run, mc_status got, mc_status want) {
+    if (got == want) return;
+    printf("repeated_runs: %s, run %d: status %d, expected %d\n", what, run, got, want);
+    failures++;
+}
+
+int main(void) {
+    mc_program *big = compile("array a[100000];\nx = 1;\n");
+    mc_program *loop = compile("i = 0;\nwhile (i < 1000) i = i + 1;\n");
+    mc_program *bad = compile("if (fail) x = b[0];\narray a[100000];\n");
+    if (!big || !loop || !bad) return 1;
+
+    mc_context *ctx = mc_context_new(big);
+    mc_set_memory_limit(ctx, 65536);
+    for (int run = 1; run <= 3; run++)
+        expect("memory limit", run, mc_run(ctx), MC_KILLED);
+    mc_context_free(ctx);
+
+    // A runtime error must not lift the memory limit either
+    ctx = mc_context_new(bad);
+    mc_set_memory_limit(ctx, 65536);
+    mc_set_var(ctx, "fail", 1);
+    expect("runtime error", 1, mc_run(ctx), MC_ERROR);
+    mc_set_var(ctx, "fail", 0);
+    expect("after a runtime error", 2, mc_run(ctx), MC_KILLED);
+    mc_context_free(ctx);
+
+    ctx = mc_context_new(loop);
+    mc_set_fuel(ctx, 100);
+    for (int run = 1; run <= 3; run++)
+        expect("fuel", run, mc_run(ctx), MC_KILLED);
+    mc_set_fuel(ctx, -1);
+    expect("unlimited fuel", 1, mc_run(ctx), MC_OK);
+    mc_context_free(ctx);
+
+    mc_program_free(big);
+    mc_program_free(loop);
+    mc_program_free(bad);
+    printf("repeated_runs: %d failures\n", failures);
+    return failures != 0;
+}
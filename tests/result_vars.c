@@ -0,0 +1,36 @@
+// A host reads a result back with mc_get_var() at every optimisation level,
+// even though the program itself never reads it.
+#include <stdio.h>
+#include <string.h>
+#include "../minicompiler.h"
+
+static const char *source =
+    "unused = 7;\n"
+    "result = n * 2 + 1;\n";
+
+int main(void) {
+    static const char *names[] = { "default", "-O0", "-O1", "-O2", "-O3" };
+    int failures = 0;
+    for (int level = MC_OPT_DEFAULT; level <= MC_OPT_O3; level++) {
+        mc_options opts = { 0, NULL, level, NULL };
+        char err[256];
+        mc_program *prog = mc_compile(source, strlen(source), &opts, err, sizeof(err));
+        if (!prog) {
+            printf("result_vars: %s: compile failed: %s\n", names[level], err);
+            failures++;
+            continue;
+        }
+        mc_context *ctx = mc_context_new(prog);
+        mc_set_var(ctx, "n", 20);
+        int result = 0, unused = 0;
+        if (mc_run(ctx) != MC_OK || !mc_get_var(ctx, "result", &result) || result != 41
+            || !mc_get_var(ctx, "unused", &unused) || unused != 7) {
+            printf("result_vars: %s: got result = %d, unused = %d\n", names[level], result, unused);
+            failures++;
+        }
+        mc_context_free(ctx);
+        mc_program_free(prog);
+    }
+    printf("result_vars: %d of 5 levels wrong\n", failures);
+    return failures != 0;
+}
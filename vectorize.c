@@ -0,0 +1,470 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VEC_X86 1
+#endif
+#include "vectorize.h"
+#include "passes.h"
+
+int vectorize_enabled = 1;
+
+#define VEC_BLOCK 512
+#define VEC_MAX_DEPTH 16
+
+// --- Kernels ---
+// All arithmetic wraps like the scalar interpreter's int operations.
+typedef struct {
+    void (*add)(int *dst, const int *a, const int *b, int n);
+    void (*sub)(int *dst, const int *a, const int *b, int n);
+    void (*mul)(int *dst, const int *a, const int *b, int n);
+    int (*sum)(const int *a, int n);
+    int (*min)(const int *a, int n);
+    int (*max)(const int *a, int n);
+} VecKernels;
+
+static void add_scalar(int *dst, const int *a, const int *b, int n) {
+    for (int i = 0; i < n; i++) dst[i] = (int)((unsigned)a[i] + (unsigned)b[i]);
+}
+
+static void sub_scalar(int *dst, const int *a, const int *b, int n) {
+    for (int i = 0; i < n; i++) dst[i] = (int)((unsigned)a[i] - (unsigned)b[i]);
+}
+
+static void mul_scalar(int *dst, const int *a, const int *b, int n) {
+    for (int i = 0; i < n; i++) dst[i] = (int)((unsigned)a[i] * (unsigned)b[i]);
+}
+
+static int sum_scalar(const int *a, int n) {
+    unsigned s = 0;
+    for (int i = 0; i < n; i++) s += (unsigned)a[i];
+    return (int)s;
+}
+
+static int min_scalar(const int *a, int n) {
+    int m = a[0];
+    for (int i = 1; i < n; i++) if (a[i] < m) m = a[i];
+    return m;
+}
+
+static int max_scalar(const int *a, int n) {
+    int m = a[0];
+    for (int i = 1; i < n; i++) if (a[i] > m) m = a[i];
+    return m;
+}
+
+static const VecKernels scalar_kernels = {
+    add_scalar, sub_scalar, mul_scalar, sum_scalar, min_scalar, max_scalar
+};
+
+#ifdef VEC_X86
+#define SSE41 __attribute__((target("sse4.1")))
+#define AVX2 __attribute__((target("avx2")))
+
+SSE41 static void add_sse(int *dst, const int *a, const int *b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(a + i)),
+                                                             _mm_loadu_si128((const __m128i *)(b + i))));
+    add_scalar(dst + i, a + i, b + i, n - i);
+}
+
+SSE41 static void sub_sse(int *dst, const int *a, const int *b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(a + i)),
+                                                             _mm_loadu_si128((const __m128i *)(b + i))));
+    sub_scalar(dst + i, a + i, b + i, n - i);
+}
+
+SSE41 static void mul_sse(int *dst, const int *a, const int *b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(a + i)),
+                                                               _mm_loadu_si128((const __m128i *)(b + i))));
+    mul_scalar(dst + i, a + i, b + i, n - i);
+}
+
+SSE41 static int sum_sse(const int *a, int n) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_epi32(acc, _mm_loadu_si128((const __m128i *)(a + i)));
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    return (int)((unsigned)sum_scalar(lanes, 4) + (unsigned)sum_scalar(a + i, n - i));
+}
+
+SSE41 static int min_sse(const int *a, int n) {
+    if (n < 4) return min_scalar(a, n);
+    __m128i acc = _mm_loadu_si128((const __m128i *)a);
+    int i = 4;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_min_epi32(acc, _mm_loadu_si128((const __m128i *)(a + i)));
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    int m = min_scalar(lanes, 4);
+    return i < n && min_scalar(a + i, n - i) < m ? min_scalar(a + i, n - i) : m;
+}
+
+SSE41 static int max_sse(const int *a, int n) {
+    if (n < 4) return max_scalar(a, n);
+    __m128i acc = _mm_loadu_si128((const __m128i *)a);
+    int i = 4;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_max_epi32(acc, _mm_loadu_si128((const __m128i *)(a + i)));
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    int m = max_scalar(lanes, 4);
+    return i < n && max_scalar(a + i, n - i) > m ? max_scalar(a + i, n - i) : m;
+}
+
+AVX2 static void add_avx2(int *dst, const int *a, const int *b, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                                                    _mm256_loadu_si256((const __m256i *)(b + i))));
+    add_scalar(dst + i, a + i, b + i, n - i);
+}
+
+AVX2 static void sub_avx2(int *dst, const int *a, const int *b, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                                                    _mm256_loadu_si256((const __m256i *)(b + i))));
+    sub_scalar(dst + i, a + i, b + i, n - i);
+}
+
+AVX2 static void mul_avx2(int *dst, const int *a, const int *b, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                                                      _mm256_loadu_si256((const __m256i *)(b + i))));
+    mul_scalar(dst + i, a + i, b + i, n - i);
+}
+
+AVX2 static int sum_avx2(const int *a, int n) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_add_epi32(acc, _mm256_loadu_si256((const __m256i *)(a + i)));
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    return (int)((unsigned)sum_scalar(lanes, 8) + (unsigned)sum_scalar(a + i, n - i));
+}
+
+AVX2 static int min_avx2(const int *a, int n) {
+    if (n < 8) return min_scalar(a, n);
+    __m256i acc = _mm256_loadu_si256((const __m256i *)a);
+    int i = 8;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_min_epi32(acc, _mm256_loadu_si256((const __m256i *)(a + i)));
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    int m = min_scalar(lanes, 8);
+    return i < n && min_scalar(a + i, n - i) < m ? min_scalar(a + i, n - i) : m;
+}
+
+AVX2 static int max_avx2(const int *a, int n) {
+    if (n < 8) return max_scalar(a, n);
+    __m256i acc = _mm256_loadu_si256((const __m256i *)a);
+    int i = 8;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_max_epi32(acc, _mm256_loadu_si256((const __m256i *)(a + i)));
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    int m = max_scalar(lanes, 8);
+    return i < n && max_scalar(a + i, n - i) > m ? max_scalar(a + i, n - i) : m;
+}
+
+static const VecKernels sse_kernels = { add_sse, sub_sse, mul_sse, sum_sse, min_sse, max_sse };
+static const VecKernels avx2_kernels = { add_avx2, sub_avx2, mul_avx2, sum_avx2, min_avx2, max_avx2 };
+#endif
+
+// Pick the widest kernel set the CPU supports, once.
+static const VecKernels *kernels(void) {
+    static const VecKernels *selected = NULL;
+    if (!selected) {
+        selected = &scalar_kernels;
+#ifdef VEC_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) selected = &avx2_kernels;
+        else if (__builtin_cpu_supports("sse4.1")) selected = &sse_kernels;
+#endif
+    }
+    return selected;
+}
+
+// --- Loop recognition ---
+static int is_id(ASTNode *e, const char *name) {
+    return e && e->type == NODE_ID && strcmp(e->data.id_name, name) == 0;
+}
+
+static int is_num(ASTNode *e, int value) {
+    return e && e->type == NODE_NUM && e->data.num_val == value;
+}
+
+static ASTNode *single_statement(ASTNode *body) {
+    if (body && body->type == NODE_BLOCK)
+        return body->data.block.count == 1 ? body->data.block.statements[0] : NULL;
+    return body;
+}
+
+// Loop-invariant bound: no reference to the loop variable, the loop target
+// or any array element.
+static int invariant_ok(ASTNode *e, const char *var, const char *target, int depth) {
+    if (depth > VEC_MAX_DEPTH) return 0;
+    switch (e->type) {
+        case NODE_NUM: return 1;
+        case NODE_ID: return strcmp(e->data.id_name, var) != 0 && strcmp(e->data.id_name, target) != 0;
+        case NODE_BINOP:
+            return invariant_ok(e->data.binop.left, var, target, depth + 1)
+                && invariant_ok(e->data.binop.right, var, target, depth + 1);
+        default: return 0;
+    }
+}
+
+// Per-element expression over a[var], constants and invariant scalars.
+// A reduction's accumulator may not appear in it; a map's destination array
+// may, since each element only reads its own slot.
+static int element_ok(ASTNode *e, const char *var, const char *target, int is_map, int depth) {
+    if (depth > VEC_MAX_DEPTH) return 0;
+    switch (e->type) {
+        case NODE_NUM:
+            return 1;
+        case NODE_ID:
+            return strcmp(e->data.id_name, var) != 0 && strcmp(e->data.id_name, target) != 0;
+        case NODE_INDEX:
+            return is_id(e->data.index.index, var) && (is_map || strcmp(e->data.index.name, target) != 0);
+        case NODE_BINOP: {
+            const char *op = e->data.binop.op;
+            if (strcmp(op, "+") != 0 && strcmp(op, "-") != 0 && strcmp(op, "*") != 0) return 0;
+            return element_ok(e->data.binop.left, var, target, is_map, depth + 1)
+                && element_ok(e->data.binop.right, var, target, is_map, depth + 1);
+        }
+        default:
+            return 0;
+    }
+}
+
+static int same_expr(ASTNode *a, ASTNode *b, int depth) {
+    if (depth > VEC_MAX_DEPTH || a->type != b->type) return 0;
+    switch (a->type) {
+        case NODE_NUM: return a->data.num_val == b->data.num_val;
+        case NODE_ID: return strcmp(a->data.id_name, b->data.id_name) == 0;
+        case NODE_INDEX:
+            return strcmp(a->data.index.name, b->data.index.name) == 0 && same_expr(a->data.index.index, b->data.index.index, depth + 1);
+        case NODE_BINOP:
+            return strcmp(a->data.binop.op, b->data.binop.op) == 0
+                && same_expr(a->data.binop.left, b->data.binop.left, depth + 1)
+                && same_expr(a->data.binop.right, b->data.binop.right, depth + 1);
+        default: return 0;
+    }
+}
+
+// if (E < m) m = E;  and the mirrored / max forms
+static int match_min_max(ASTNode *stmt, const char *var, VecLoop *plan) {
+    if (stmt->type != NODE_IF || stmt->data.if_stmt.else_branch) return 0;
+    ASTNode *cond = stmt->data.if_stmt.cond;
+    ASTNode *assign = single_statement(stmt->data.if_stmt.then_branch);
+    if (!cond || cond->type != NODE_BINOP || !assign || assign->type != NODE_ASSIGN) return 0;
+
+    const char *acc = assign->data.assign.id;
+    const char *op = cond->data.binop.op;
+    ASTNode *elem;
+    int less; // true when the condition reads "elem < acc"
+    if (is_id(cond->data.binop.right, acc)) {
+        elem = cond->data.binop.left;
+        less = op[0] == '<';
+    } else if (is_id(cond->data.binop.left, acc)) {
+        elem = cond->data.binop.right;
+        less = op[0] == '>';
+    } else {
+        return 0;
+    }
+    if (op[0] != '<' && op[0] != '>') return 0;
+    if (strcmp(acc, var) == 0 || !same_expr(elem, assign->data.assign.expr, 0)) return 0;
+    if (!element_ok(elem, var, acc, 0, 0)) return 0;
+    plan->kind = less ? VEC_MIN : VEC_MAX;
+    plan->target = acc;
+    plan->expr = elem;
+    return 1;
+}
+
+static VecLoop *analyse_for(ASTNode *node) {
+    ASTNode *cond = node->data.for_stmt.cond;
+    ASTNode *inc = node->data.for_stmt.inc;
+    ASTNode *stmt = single_statement(node->data.for_stmt.body);
+    if (!cond || !inc || !stmt || cond->type != NODE_BINOP || cond->data.binop.left->type != NODE_ID)
+        return NULL;
+
+    VecLoop plan = {0};
+    plan.var = cond->data.binop.left->data.id_name;
+    if (strcmp(cond->data.binop.op, "<") == 0) plan.inclusive = 0;
+    else if (strcmp(cond->data.binop.op, "<=") == 0) plan.inclusive = 1;
+    else return NULL;
+    plan.limit = cond->data.binop.right;
+
+    // i = i + 1 or i = 1 + i
+    ASTNode *step = inc->type == NODE_ASSIGN ? inc->data.assign.expr : NULL;
+    if (inc->type != NODE_ASSIGN || strcmp(inc->data.assign.id, plan.var) != 0
+        || step->type != NODE_BINOP || strcmp(step->data.binop.op, "+") != 0
+        || !((is_id(step->data.binop.left, plan.var) && is_num(step->data.binop.right, 1))
+             || (is_num(step->data.binop.left, 1) && is_id(step->data.binop.right, plan.var))))
+        return NULL;
+
+    if (stmt->type == NODE_INDEX_ASSIGN) {
+        if (!is_id(stmt->data.index_assign.index, plan.var)) return NULL;
+        plan.kind = VEC_MAP;
+        plan.target = stmt->data.index_assign.name;
+        plan.expr = stmt->data.index_assign.expr;
+        if (!element_ok(plan.expr, plan.var, plan.target, 1, 0)) return NULL;
+    } else if (stmt->type == NODE_ASSIGN) {
+        // s = s + E or s = E + s
+        ASTNode *rhs = stmt->data.assign.expr;
+        const char *acc = stmt->data.assign.id;
+        if (strcmp(acc, plan.var) == 0 || rhs->type != NODE_BINOP || strcmp(rhs->data.binop.op, "+") != 0)
+            return NULL;
+        if (is_id(rhs->data.binop.left, acc)) plan.expr = rhs->data.binop.right;
+        else if (is_id(rhs->data.binop.right, acc)) plan.expr = rhs->data.binop.left;
+        else return NULL;
+        plan.kind = VEC_SUM;
+        plan.target = acc;
+        if (!element_ok(plan.expr, plan.var, acc, 0, 0)) return NULL;
+    } else if (!match_min_max(stmt, plan.var, &plan)) {
+        return NULL;
+    }
+
+    if (!invariant_ok(plan.limit, plan.var, plan.target, 0)) return NULL;
+    VecLoop *loop = malloc(sizeof(VecLoop));
+    *loop = plan;
+    return loop;
+}
+
+// Attach a plan to every for loop that matches one of the supported shapes.
+void vectorize_loops(ASTNode *node, PassStats *stats) {
+    WalkStack s;
+    walk_init(&s);
+    walk_push(&s, &node, 0);
+    while (s.count) {
+        node = s.items[--s.count].node;
+        stats->visited++;
+        switch (node->type) {
+            case NODE_BLOCK:
+                for (int i = node->data.block.count - 1; i >= 0; i--)
+                    walk_push(&s, &node->data.block.statements[i], 0);
+                break;
+            case NODE_IF:
+                walk_push(&s, &node->data.if_stmt.else_branch, 0);
+                walk_push(&s, &node->data.if_stmt.then_branch, 0);
+                break;
+            case NODE_WHILE:
+                walk_push(&s, &node->data.while_stmt.body, 0);
+                break;
+            case NODE_FOR:
+                vec_free(node->data.for_stmt.vec);
+                node->data.for_stmt.vec = analyse_for(node);
+                if (!node->data.for_stmt.vec) walk_push(&s, &node->data.for_stmt.body, 0);
+                break;
+            default:
+                break;
+        }
+    }
+    walk_done(&s);
+}
+
+void vec_free(VecLoop *loop) {
+    free(loop);
+}
+
+// --- Execution ---
+// Every name the element expression touches must already exist, and every
+// array must cover [start, start + n); otherwise the scalar loop runs and
+// reports the error exactly as before.
+static int operands_ready(ASTNode *e, int start, long long n) {
+    int value, length;
+    switch (e->type) {
+        case NODE_NUM:
+            return 1;
+        case NODE_ID:
+            return lookup_var(e->data.id_name, &value);
+        case NODE_INDEX:
+            return lookup_array(e->data.index.name, &length) && start >= 0 && start + n <= length;
+        case NODE_BINOP:
+            return operands_ready(e->data.binop.left, start, n) && operands_ready(e->data.binop.right, start, n);
+        default:
+            return 0;
+    }
+}
+
+// Evaluate e for elements [first, first + n) into buf, or return a pointer
+// straight into the array for a plain a[i].
+static const int *eval_block(const VecKernels *k, ASTNode *e, int first, int n, int *buf) {
+    int value, length;
+    switch (e->type) {
+        case NODE_INDEX:
+            return lookup_array(e->data.index.name, &length) + first;
+        case NODE_NUM:
+        case NODE_ID:
+            value = e->type == NODE_NUM ? e->data.num_val : get_var(e->data.id_name);
+            for (int i = 0; i < n; i++) buf[i] = value;
+            return buf;
+        default: {
+            int tmp[VEC_BLOCK];
+            const int *l = eval_block(k, e->data.binop.left, first, n, buf);
+            const int *r = eval_block(k, e->data.binop.right, first, n, tmp);
+            char op = e->data.binop.op[0];
+            if (op == '+') k->add(buf, l, r, n);
+            else if (op == '-') k->sub(buf, l, r, n);
+            else k->mul(buf, l, r, n);
+            return buf;
+        }
+    }
+}
+
+int vec_run(VecLoop *loop) {
+    if (!vectorize_enabled) return 0;
+    int start, acc = 0, length;
+    if (!lookup_var(loop->var, &start)) return 0;
+    int limit = eval_expr(loop->limit);
+    if (loop->inclusive && limit == INT_MAX) return 0;
+    long long n = (long long)limit - start + loop->inclusive;
+    if (n <= 0 || !operands_ready(loop->expr, start, n)) return 0;
+    if (loop->kind == VEC_MAP) {
+        int *dst = lookup_array(loop->target, &length);
+        if (!dst || start < 0 || start + n > length) return 0;
+    } else if (!lookup_var(loop->target, &acc)) {
+        return 0;
+    }
+
+    const VecKernels *k = kernels();
+    int buf[VEC_BLOCK];
+    for (long long done = 0; done < n; done += VEC_BLOCK) {
+        int first = start + (int)done;
+        int count = n - done < VEC_BLOCK ? (int)(n - done) : VEC_BLOCK;
+        const int *values = eval_block(k, loop->expr, first, count, buf);
+        switch (loop->kind) {
+            case VEC_MAP:
+                memmove(lookup_array(loop->target, &length) + first, values, sizeof(int) * count);
+                break;
+            case VEC_SUM:
+                acc = (int)((unsigned)acc + (unsigned)k->sum(values, count));
+                break;
+            case VEC_MIN: {
+                int m = k->min(values, count);
+                if (m < acc) acc = m;
+                break;
+            }
+            case VEC_MAX: {
+                int m = k->max(values, count);
+                if (m > acc) acc = m;
+                break;
+            }
+        }
+    }
+    if (loop->kind != VEC_MAP) set_var(loop->target, acc);
+    set_var(loop->var, (int)(start + n));
+    return 1;
+}
@@ -0,0 +1,29 @@
+#ifndef VECTORIZE_H
+#define VECTORIZE_H
+
+#include "ast.h"
+
+// Loops of the form
+//   for (i = lo; i < hi; i = i + 1) c[i] = <expr>;
+//   for (i = lo; i < hi; i = i + 1) s = s + <expr>;
+//   for (i = lo; i < hi; i = i + 1) if (<expr> < m) m = <expr>;   (or > for max)
+// where <expr> combines a[i], constants and loop-invariant scalars with + - *,
+// are run a block at a time with SSE/AVX2 kernels instead of per iteration.
+typedef enum { VEC_MAP, VEC_SUM, VEC_MIN, VEC_MAX } VecKind;
+
+struct VecLoop {
+    VecKind kind;
+    const char *var;    // loop variable
+    int inclusive;      // condition is i <= limit
+    ASTNode *limit;     // loop-invariant bound
+    const char *target; // destination array (VEC_MAP) or accumulator
+    ASTNode *expr;      // per-element expression
+};
+
+extern int vectorize_enabled;
+
+void vectorize_loops(ASTNode *node, PassStats *stats);
+int vec_run(VecLoop *loop);
+void vec_free(VecLoop *loop);
+
+#endif